@@ -0,0 +1,126 @@
+/**
+ * @file startup_bench.cpp
+ * @author daguai
+ * @version 1.0
+ *
+ * @brief 测量scheduler从创建到运行完一个空任务的耗时, 比较不同io_uring创建方式的启动开销
+ *
+ * 用法: startup_bench [rounds]
+ */
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+#include "coro/coro.hpp"
+#include "coro/io/io_awaiter.hpp"
+
+using namespace coro;
+
+/*************************************************************
+ *                       pre-definition                      *
+ *************************************************************/
+
+using clock_type = std::chrono::steady_clock;
+
+struct bench_case
+{
+    const char*    name;
+    engine_options opts;
+    bool           do_io; // 是否在每个context上发起一次IO
+};
+
+struct bench_result
+{
+    double init_us{0}; // 构造scheduler的平均耗时
+    double run_us{0};  // 启动工作线程, 执行任务直到全部退出的平均耗时
+};
+
+task<> empty_func()
+{
+    co_return;
+}
+
+/**
+ * @brief 在每个context上发起一次nop IO, 触发io_uring的创建
+ */
+task<> touch_io_func()
+{
+    for (size_t i = 0; i < scheduler::context_count(); i++)
+    {
+        co_await switch_to(i);
+        co_await io::noop_awaiter{};
+    }
+}
+
+auto elapsed_us(clock_type::time_point start, clock_type::time_point end) noexcept -> double
+{
+    return std::chrono::duration<double, std::micro>(end - start).count();
+}
+
+auto run_case(const bench_case& bc, size_t ctx_cnt, int rounds) noexcept -> bench_result
+{
+    bench_result res;
+    for (int i = 0; i < rounds; i++)
+    {
+        auto start = clock_type::now();
+        {
+            scheduler sched(scheduler_options{.ctx_cnt = ctx_cnt, .engine_opts = bc.opts});
+            auto      inited = clock_type::now();
+            if (bc.do_io)
+            {
+                sync_wait(sched, touch_io_func());
+            }
+            else
+            {
+                sync_wait(sched, empty_func());
+            }
+            auto finished = clock_type::now();
+            res.init_us += elapsed_us(start, inited);
+            res.run_us += elapsed_us(inited, finished);
+        }
+    }
+    res.init_us /= rounds;
+    res.run_us /= rounds;
+    return res;
+}
+
+/*************************************************************
+ *                          bench                            *
+ *************************************************************/
+
+int main(int argc, char** argv)
+{
+    int rounds = argc > 1 ? std::atoi(argv[1]) : 20;
+    if (rounds <= 0)
+    {
+        rounds = 1;
+    }
+
+    std::vector<bench_case> cases = {
+        {"eager, 10240 entries", engine_options{.entry_length = 10240, .lazy_ring = false, .attach_wq = false}, false},
+        {"eager, default", engine_options{.lazy_ring = false}, false},
+        {"lazy, no io", engine_options{}, false},
+        {"lazy, io on all", engine_options{}, true},
+        {"lazy, io on all, no attach_wq", engine_options{.attach_wq = false}, true},
+    };
+
+    std::vector<size_t> ctx_cnts = {1, 4};
+    if (std::thread::hardware_concurrency() > 4)
+    {
+        ctx_cnts.push_back(std::thread::hardware_concurrency());
+    }
+
+    std::printf("rounds: %d, default entry length: %u\n", rounds, config::kEntryLength);
+    std::printf("%-32s %8s %12s %12s\n", "case", "contexts", "init(us)", "run(us)");
+    for (auto ctx_cnt : ctx_cnts)
+    {
+        for (auto& bc : cases)
+        {
+            auto res = run_case(bc, ctx_cnt, rounds);
+            std::printf("%-32s %8zu %12.1f %12.1f\n", bc.name, ctx_cnt, res.init_us, res.run_us);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,242 @@
+/**
+* @file async_generator.hpp
+* @author daguai
+* @version 1.0
+*/
+#pragma once
+
+#include <coroutine>
+#include <exception>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#include "coro/attribute.hpp"
+
+namespace coro
+{
+template<typename yield_type>
+class async_generator;
+
+namespace detail
+{
+template<typename yield_type>
+class async_generator_promise
+{
+public:
+    using storage_type   = std::remove_reference_t<yield_type>;
+    using reference_type = std::conditional_t<std::is_reference_v<yield_type>, yield_type, yield_type&>;
+
+    /**
+     * @brief co_yield与结束时把执行权对称转移回消费者
+     */
+    struct yield_awaiter
+    {
+        constexpr auto await_ready() const noexcept -> bool { return false; }
+
+        auto await_suspend(std::coroutine_handle<async_generator_promise> coroutine) noexcept
+            -> std::coroutine_handle<>
+        {
+            return coroutine.promise().m_consumer;
+        }
+
+        constexpr auto await_resume() const noexcept -> void {}
+    };
+
+    async_generator_promise() noexcept = default;
+    ~async_generator_promise()         = default;
+
+    auto get_return_object() noexcept -> async_generator<yield_type>;
+
+    constexpr auto initial_suspend() const noexcept { return std::suspend_always{}; }
+
+    auto final_suspend() noexcept -> yield_awaiter
+    {
+        m_value = nullptr;
+        return {};
+    }
+
+    /**
+     * @brief 只记录被yield对象的地址, 对象在生成器恢复前一直有效, 因此不需要复制
+     */
+    auto yield_value(storage_type& value) noexcept -> yield_awaiter
+    {
+        m_value = std::addressof(value);
+        return {};
+    }
+
+    auto yield_value(storage_type&& value) noexcept -> yield_awaiter
+    {
+        m_value = std::addressof(value);
+        return {};
+    }
+
+    constexpr auto return_void() noexcept -> void {}
+
+    auto unhandled_exception() noexcept -> void { m_exception_ptr = std::current_exception(); }
+
+    inline auto value() const noexcept -> reference_type { return static_cast<reference_type>(*m_value); }
+
+    inline auto consumer(std::coroutine_handle<> consumer) noexcept -> void { m_consumer = consumer; }
+
+    auto rethrow_if_exception() -> void
+    {
+        if (m_exception_ptr)
+        {
+            std::rethrow_exception(std::exchange(m_exception_ptr, nullptr));
+        }
+    }
+
+private:
+    storage_type*           m_value{nullptr};
+    std::coroutine_handle<> m_consumer{nullptr}; // 等待下一个元素的协程
+    std::exception_ptr      m_exception_ptr{nullptr};
+};
+}; // namespace detail
+
+/**
+ * @brief 异步生成器, 两次co_yield之间可以co_await IO等操作
+ *
+ * 用法:
+ *   auto it = co_await gen.begin();
+ *   while (it != gen.end()) { use(*it); co_await ++it; }
+ *
+ * 消费者与生成器之间通过对称转移切换, 生成器挂起等待IO时消费者保持挂起,
+ * IO完成后生成器在其所在的context上恢复并把下一个元素交给消费者.
+ * promise中只保存元素的指针, 每个元素都不会产生复制与内存分配, 协程帧与task一样通过operator new分配.
+ *
+ * @note 生成器挂起等待IO期间不能销毁async_generator
+ */
+template<typename yield_type>
+class async_generator
+{
+public:
+    using promise_type     = detail::async_generator_promise<yield_type>;
+    using coroutine_handle = std::coroutine_handle<promise_type>;
+
+    class iterator
+    {
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using difference_type   = std::ptrdiff_t;
+        using value_type        = std::remove_cvref_t<typename promise_type::storage_type>;
+        using reference         = typename promise_type::reference_type;
+        using pointer           = std::add_pointer_t<reference>;
+
+        struct [[CORO_AWAIT_HINT]] advance_awaiter
+        {
+            explicit advance_awaiter(iterator& it) noexcept : m_it(it) {}
+
+            auto await_ready() const noexcept -> bool
+            {
+                return m_it.m_coroutine == nullptr || m_it.m_coroutine.done();
+            }
+
+            auto await_suspend(std::coroutine_handle<> handle) noexcept -> std::coroutine_handle<>
+            {
+                m_it.m_coroutine.promise().consumer(handle);
+                return m_it.m_coroutine;
+            }
+
+            auto await_resume() -> iterator&
+            {
+                if (m_it.m_coroutine != nullptr && m_it.m_coroutine.done())
+                {
+                    m_it.m_coroutine.promise().rethrow_if_exception();
+                }
+                return m_it;
+            }
+
+            iterator& m_it;
+        };
+
+        iterator() noexcept = default;
+        explicit iterator(coroutine_handle coroutine) noexcept : m_coroutine(coroutine) {}
+
+        auto operator==(std::default_sentinel_t) const noexcept -> bool
+        {
+            return m_coroutine == nullptr || m_coroutine.done();
+        }
+
+        /**
+         * @brief 恢复生成器直到产生下一个元素, 用法: co_await ++it;
+         */
+        auto operator++() noexcept -> advance_awaiter { return advance_awaiter(*this); }
+
+        auto operator*() const noexcept -> reference { return m_coroutine.promise().value(); }
+
+        auto operator->() const noexcept -> pointer { return std::addressof(operator*()); }
+
+    private:
+        coroutine_handle m_coroutine{nullptr};
+    };
+
+    struct [[CORO_AWAIT_HINT]] begin_awaiter
+    {
+        explicit begin_awaiter(coroutine_handle coroutine) noexcept : m_it(coroutine) {}
+
+        auto await_ready() noexcept -> bool { return advance().await_ready(); }
+
+        auto await_suspend(std::coroutine_handle<> handle) noexcept -> std::coroutine_handle<>
+        {
+            return advance().await_suspend(handle);
+        }
+
+        auto await_resume() -> iterator { return advance().await_resume(); }
+
+        inline auto advance() noexcept -> typename iterator::advance_awaiter { return ++m_it; }
+
+        iterator m_it;
+    };
+
+    async_generator() noexcept = default;
+    explicit async_generator(coroutine_handle coroutine) noexcept : m_coroutine(coroutine) {}
+
+    async_generator(const async_generator&) = delete;
+    async_generator(async_generator&& other) noexcept : m_coroutine(std::exchange(other.m_coroutine, nullptr)) {}
+
+    auto operator=(const async_generator&) -> async_generator& = delete;
+
+    auto operator=(async_generator&& other) noexcept -> async_generator&
+    {
+        if (std::addressof(other) != this)
+        {
+            if (m_coroutine != nullptr)
+            {
+                m_coroutine.destroy();
+            }
+            m_coroutine = std::exchange(other.m_coroutine, nullptr);
+        }
+        return *this;
+    }
+
+    ~async_generator()
+    {
+        if (m_coroutine != nullptr)
+        {
+            m_coroutine.destroy();
+        }
+    }
+
+    /**
+     * @brief 启动生成器直到产生第一个元素, 只能调用一次, 用法: auto it = co_await gen.begin();
+     */
+    auto begin() noexcept -> begin_awaiter { return begin_awaiter(m_coroutine); }
+
+    constexpr auto end() const noexcept -> std::default_sentinel_t { return {}; }
+
+private:
+    coroutine_handle m_coroutine{nullptr};
+};
+
+namespace detail
+{
+template<typename yield_type>
+inline auto async_generator_promise<yield_type>::get_return_object() noexcept -> async_generator<yield_type>
+{
+    return async_generator<yield_type>{std::coroutine_handle<async_generator_promise>::from_promise(*this)};
+}
+}; // namespace detail
+
+}; // namespace coro
@@ -11,6 +11,7 @@ template <class Queue, size_t Capacity>
 struct CapacityToConstructor : Queue
 {
     CapacityToConstructor() : Queue(Capacity) {}
+    explicit CapacityToConstructor(size_t capacity) : Queue(capacity) {}
 };
 
 
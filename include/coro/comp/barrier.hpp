@@ -0,0 +1,102 @@
+/**
+* @file barrier.hpp
+* @author daguai
+* @version 1.0
+*/
+#pragma once
+
+#include <coroutine>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+
+#include "coro/attribute.hpp"
+#include "coro/detail/types.hpp"
+
+namespace coro
+{
+class context;
+
+/**
+ * @brief 可重复使用的协程屏障
+ *
+ * 每个阶段需要expected个协程到达, 最后一个到达的协程执行completion(如果有), 然后唤醒本阶段的全部等待者,
+ * 屏障自动进入下一个阶段. 阶段之间只递增m_generation并复用同一组成员, 不需要重新构造或分配内存.
+ */
+class barrier
+{
+public:
+    using completion_type = std::function<void()>;
+
+    struct [[CORO_AWAIT_HINT]] awaiter
+    {
+        awaiter(context& ctx, barrier& bar) noexcept : m_ctx(ctx), m_bar(bar) {}
+
+        constexpr auto await_ready() noexcept -> bool { return false; }
+
+        auto await_suspend(std::coroutine_handle<> handle) noexcept -> bool;
+
+        /**
+         * @return 本次到达所属阶段的序号, 从0开始
+         */
+        auto await_resume() noexcept -> uint64_t;
+
+        context&                m_ctx;                                 // 等待者所在的context
+        barrier&                m_bar;                                 // 关联的barrier
+        uint64_t                m_generation{0};                       // 到达时的阶段序号
+        awaiter*                m_next{nullptr};                       // 链表next
+        std::coroutine_handle<> m_await_coro{nullptr};                 // 恢复用的协程句柄, 只在挂起时设置
+        detail::task_priority   m_prio{detail::task_priority::normal}; // 等待者的优先级, 挂起时记录
+    };
+
+    /**
+     * @param expected 每个阶段需要到达的协程数
+     * @param completion 每个阶段结束时由最后一个到达的协程执行一次, 执行时本阶段的等待者尚未被唤醒
+     */
+    explicit barrier(uint32_t expected, completion_type completion = nullptr) noexcept
+        : m_expected(expected),
+          m_completion(std::move(completion))
+    {
+    }
+
+    ~barrier() noexcept = default;
+
+    CORO_NO_COPY_MOVE(barrier);
+
+    /**
+     * @brief 到达并等待本阶段的其他协程
+     */
+    auto arrive_and_wait() noexcept -> awaiter;
+
+    /**
+     * @brief 到达本阶段但不等待, 并把之后每个阶段需要到达的协程数减一
+     */
+    auto arrive_and_drop() noexcept -> void;
+
+    /**
+     * @brief 当前阶段的序号
+     */
+    auto generation() noexcept -> uint64_t;
+
+private:
+    /**
+     * @brief 在m_mtx保护下登记一次到达, 本阶段结束时返回true并切换到下一个阶段, 被唤醒的等待者通过waiters返回
+     */
+    auto arrive_locked(awaiter*& waiters) noexcept -> bool;
+
+    /**
+     * @brief 在锁外执行completion并唤醒上一个阶段的等待者
+     */
+    auto complete_phase(awaiter* waiters) noexcept -> void;
+
+private:
+    std::mutex      m_mtx;           // 保护以下全部状态
+    uint32_t        m_expected;      // 当前阶段需要到达的协程数
+    uint32_t        m_arrived{0};    // 当前阶段已经到达的协程数
+    uint32_t        m_dropped{0};    // 当前阶段调用arrive_and_drop的次数, 阶段结束时从m_expected中扣除
+    uint64_t        m_generation{0}; // 阶段序号
+    awaiter*        m_head{nullptr}; // 当前阶段的等待者
+    completion_type m_completion;
+};
+
+}; // namespace coro
@@ -0,0 +1,331 @@
+/**
+* @file channel.hpp
+* @author daguai
+* @version 1.0
+*/
+#pragma once
+
+#include <cassert>
+#include <coroutine>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+#include "coro/attribute.hpp"
+#include "coro/context.hpp"
+#include "coro/detail/resume_batch.hpp"
+
+namespace coro
+{
+/**
+ * @brief 有界的多生产者多消费者协程channel
+ *
+ * capacity大于0时为带缓冲的环形队列, 缓冲区满时send挂起, 为空时recv挂起.
+ * capacity为0时为无缓冲的rendezvous模式, send会挂起直到有recv取走数据.
+ * 有协程在等待时数据直接在发送者与接收者之间移交, 被唤醒的协程无需重新竞争, 数据全程move不会复制.
+ * 内部状态由一把短临界区的std::mutex保护, 协程的挂起与恢复都在锁外完成.
+ *
+ * close之后send立即失败, recv仍可以取出缓冲区中剩余的数据, 取完后返回std::nullopt.
+ */
+template<typename value_type>
+class channel
+{
+    static_assert(std::is_move_constructible_v<value_type>, "channel value_type must be move constructible");
+
+public:
+    struct [[CORO_AWAIT_HINT]] send_awaiter
+    {
+        send_awaiter(context& ctx, channel& ch, value_type&& value) noexcept(
+            std::is_nothrow_move_constructible_v<value_type>)
+            : m_ctx(ctx),
+              m_ch(ch),
+              m_value(std::move(value))
+        {
+        }
+
+        constexpr auto await_ready() noexcept -> bool { return false; }
+
+        auto await_suspend(std::coroutine_handle<> handle) noexcept -> bool { return m_ch.send_or_park(this, handle); }
+
+        /**
+         * @return 数据是否已经交给channel, channel关闭时为false
+         */
+        auto await_resume() noexcept -> bool
+        {
+            if (m_await_coro != nullptr)
+            {
+                m_ctx.unregister_wait();
+            }
+            return m_ok;
+        }
+
+        context&                m_ctx;                         // 等待者所在的context
+        channel&                m_ch;                          // 关联的channel
+        value_type              m_value;                       // 等待发送的数据
+        bool                    m_ok{false};                   // 发送结果
+        send_awaiter*           m_next{nullptr};               // 链表next
+        std::coroutine_handle<> m_await_coro{nullptr};         // 恢复用的协程句柄, 只在挂起时设置
+        task_priority           m_prio{task_priority::normal}; // 等待者的优先级, 只在挂起时设置
+    };
+
+    struct [[CORO_AWAIT_HINT]] recv_awaiter
+    {
+        recv_awaiter(context& ctx, channel& ch) noexcept : m_ctx(ctx), m_ch(ch) {}
+
+        constexpr auto await_ready() noexcept -> bool { return false; }
+
+        auto await_suspend(std::coroutine_handle<> handle) noexcept -> bool { return m_ch.recv_or_park(this, handle); }
+
+        /**
+         * @return 收到的数据, channel关闭且没有剩余数据时为std::nullopt
+         */
+        auto await_resume() noexcept -> std::optional<value_type>
+        {
+            if (m_await_coro != nullptr)
+            {
+                m_ctx.unregister_wait();
+            }
+            return std::move(m_value);
+        }
+
+        context&                  m_ctx;                         // 等待者所在的context
+        channel&                  m_ch;                          // 关联的channel
+        std::optional<value_type> m_value;                       // 收到的数据
+        recv_awaiter*             m_next{nullptr};               // 链表next
+        std::coroutine_handle<>   m_await_coro{nullptr};         // 恢复用的协程句柄, 只在挂起时设置
+        task_priority             m_prio{task_priority::normal}; // 等待者的优先级, 只在挂起时设置
+    };
+
+    /**
+     * @param capacity 缓冲区大小, 0表示无缓冲的rendezvous模式
+     */
+    explicit channel(size_t capacity) noexcept
+        : m_ring(capacity > 0 ? std::make_unique<std::optional<value_type>[]>(capacity) : nullptr),
+          m_cap(capacity)
+    {
+    }
+
+    ~channel() noexcept = default;
+
+    CORO_NO_COPY_MOVE(channel);
+
+    inline auto capacity() const noexcept -> size_t { return m_cap; }
+
+    auto send(value_type value) noexcept(std::is_nothrow_move_constructible_v<value_type>) -> send_awaiter
+    {
+        return send_awaiter(local_context(), *this, std::move(value));
+    }
+
+    auto recv() noexcept -> recv_awaiter { return recv_awaiter(local_context(), *this); }
+
+    /**
+     * @brief 不挂起的发送, 缓冲区已满且没有等待的接收者或channel已关闭时失败, 失败时value保持不变
+     */
+    auto try_send(value_type& value) noexcept -> bool
+    {
+        recv_awaiter* wake = nullptr;
+        bool          ok   = false;
+        {
+            std::lock_guard<std::mutex> lk(m_mtx);
+            ok = !m_closed && send_locked(value, wake);
+        }
+        resume(wake);
+        return ok;
+    }
+
+    /**
+     * @brief 不挂起的接收, 没有可取的数据时返回std::nullopt
+     */
+    auto try_recv() noexcept -> std::optional<value_type>
+    {
+        std::optional<value_type> value;
+        send_awaiter*             wake = nullptr;
+        {
+            std::lock_guard<std::mutex> lk(m_mtx);
+            recv_locked(value, wake);
+        }
+        resume(wake);
+        return value;
+    }
+
+    /**
+     * @brief 关闭channel, 唤醒全部等待的发送者与接收者
+     */
+    auto close() noexcept -> void
+    {
+        send_awaiter* senders   = nullptr;
+        recv_awaiter* receivers = nullptr;
+        {
+            std::lock_guard<std::mutex> lk(m_mtx);
+            m_closed    = true;
+            senders     = std::exchange(m_send_head, nullptr);
+            receivers   = std::exchange(m_recv_head, nullptr);
+            m_send_tail = nullptr;
+            m_recv_tail = nullptr;
+        }
+        detail::resume_grouped(senders);
+        detail::resume_grouped(receivers);
+    }
+
+    auto is_closed() noexcept -> bool
+    {
+        std::lock_guard<std::mutex> lk(m_mtx);
+        return m_closed;
+    }
+
+private:
+    auto send_or_park(send_awaiter* aw, std::coroutine_handle<> handle) noexcept -> bool
+    {
+        recv_awaiter* wake = nullptr;
+        {
+            std::lock_guard<std::mutex> lk(m_mtx);
+            if (!m_closed && !send_locked(aw->m_value, wake))
+            {
+                aw->m_await_coro = handle;
+                aw->m_prio       = detail::linfo.prio;
+                aw->m_ctx.register_wait();
+                push_back(m_send_head, m_send_tail, aw);
+                return true;
+            }
+            aw->m_ok = !m_closed;
+        }
+        resume(wake);
+        return false;
+    }
+
+    auto recv_or_park(recv_awaiter* aw, std::coroutine_handle<> handle) noexcept -> bool
+    {
+        send_awaiter* wake = nullptr;
+        {
+            std::lock_guard<std::mutex> lk(m_mtx);
+            if (!recv_locked(aw->m_value, wake) && !m_closed)
+            {
+                aw->m_await_coro = handle;
+                aw->m_prio       = detail::linfo.prio;
+                aw->m_ctx.register_wait();
+                push_back(m_recv_head, m_recv_tail, aw);
+                return true;
+            }
+        }
+        resume(wake);
+        return false;
+    }
+
+    /**
+     * @brief 在m_mtx保护下尝试发送, 优先直接交给等待的接收者, 其次放入缓冲区
+     *
+     * @param wake 需要在锁外恢复的接收者
+     */
+    auto send_locked(value_type& value, recv_awaiter*& wake) noexcept -> bool
+    {
+        if (auto receiver = pop_front(m_recv_head, m_recv_tail); receiver != nullptr)
+        {
+            receiver->m_value.emplace(std::move(value));
+            wake = receiver;
+            return true;
+        }
+        if (m_size < m_cap)
+        {
+            m_ring[(m_head + m_size) % m_cap].emplace(std::move(value));
+            m_size++;
+            return true;
+        }
+        return false;
+    }
+
+    /**
+     * @brief 在m_mtx保护下尝试接收, 缓冲区空出的位置由等待的发送者补上,
+     *        无缓冲模式下直接从等待的发送者取数据
+     *
+     * @param wake 需要在锁外恢复的发送者
+     */
+    auto recv_locked(std::optional<value_type>& out, send_awaiter*& wake) noexcept -> bool
+    {
+        auto sender = pop_front(m_send_head, m_send_tail);
+        if (m_size > 0)
+        {
+            auto& slot = m_ring[m_head];
+            out.emplace(std::move(*slot));
+            slot.reset();
+            m_head = (m_head + 1) % m_cap;
+            m_size--;
+            if (sender != nullptr)
+            {
+                m_ring[(m_head + m_size) % m_cap].emplace(std::move(sender->m_value));
+                m_size++;
+            }
+        }
+        else if (sender != nullptr)
+        {
+            out.emplace(std::move(sender->m_value));
+        }
+        else
+        {
+            return false;
+        }
+
+        if (sender != nullptr)
+        {
+            sender->m_ok = true;
+            wake         = sender;
+        }
+        return true;
+    }
+
+    template<typename awaiter_type>
+    static auto resume(awaiter_type* waiter) noexcept -> void
+    {
+        if (waiter != nullptr)
+        {
+            // 恢复后awaiter可能立即销毁, 提交之后不能再访问waiter
+            waiter->m_ctx.submit_next(waiter->m_await_coro, waiter->m_prio);
+        }
+    }
+
+    template<typename awaiter_type>
+    static auto push_back(awaiter_type*& head, awaiter_type*& tail, awaiter_type* waiter) noexcept -> void
+    {
+        waiter->m_next = nullptr;
+        if (tail == nullptr)
+        {
+            head = tail = waiter;
+        }
+        else
+        {
+            tail->m_next = waiter;
+            tail         = waiter;
+        }
+    }
+
+    template<typename awaiter_type>
+    static auto pop_front(awaiter_type*& head, awaiter_type*& tail) noexcept -> awaiter_type*
+    {
+        auto waiter = head;
+        if (waiter != nullptr)
+        {
+            head = waiter->m_next;
+            if (head == nullptr)
+            {
+                tail = nullptr;
+            }
+            waiter->m_next = nullptr;
+        }
+        return waiter;
+    }
+
+private:
+    std::mutex                                   m_mtx;               // 保护以下全部状态
+    std::unique_ptr<std::optional<value_type>[]> m_ring;              // 环形缓冲区
+    size_t                                       m_cap;               // 缓冲区容量
+    size_t                                       m_head{0};           // 队首位置
+    size_t                                       m_size{0};           // 缓冲的数据个数
+    bool                                         m_closed{false};
+    send_awaiter*                                m_send_head{nullptr}; // 等待中的发送者, FIFO
+    send_awaiter*                                m_send_tail{nullptr};
+    recv_awaiter*                                m_recv_head{nullptr}; // 等待中的接收者, FIFO
+    recv_awaiter*                                m_recv_tail{nullptr};
+};
+
+}; // namespace coro
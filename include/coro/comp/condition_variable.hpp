@@ -0,0 +1,88 @@
+/**
+* @file condition_variable.hpp
+* @author daguai
+* @version 1.0
+*/
+#pragma once
+
+#include <coroutine>
+#include <mutex>
+
+#include "coro/attribute.hpp"
+#include "coro/comp/mutex.hpp"
+#include "coro/detail/types.hpp"
+#include "coro/task.hpp"
+
+namespace coro
+{
+class context;
+
+/**
+ * @brief 与coro::mutex配合使用的协程条件变量
+ *
+ * wait在登记等待者之后才释放mutex, 之后调用notify的协程一定能看到该等待者, 不会丢失唤醒.
+ * 被唤醒的协程重新获取mutex后wait才返回. notify_all按等待者所属的context分组批量提交,
+ * 每个context只产生一次跨线程唤醒.
+ */
+class condition_variable
+{
+public:
+    struct [[CORO_AWAIT_HINT]] awaiter
+    {
+        awaiter(context& ctx, condition_variable& cv, mutex& mtx) noexcept : m_ctx(ctx), m_cv(cv), m_mtx(mtx) {}
+
+        constexpr auto await_ready() noexcept -> bool { return false; }
+
+        auto await_suspend(std::coroutine_handle<> handle) noexcept -> void;
+
+        auto await_resume() noexcept -> void;
+
+        context&                m_ctx;                                 // 等待者所在的context
+        condition_variable&     m_cv;                                  // 关联的condition_variable
+        mutex&                  m_mtx;                                 // 挂起后释放的mutex
+        awaiter*                m_next{nullptr};                       // 链表next
+        std::coroutine_handle<> m_await_coro{nullptr};                 // 恢复用的协程句柄
+        detail::task_priority   m_prio{detail::task_priority::normal}; // 等待者的优先级, 挂起时记录
+    };
+
+    condition_variable() noexcept  = default;
+    ~condition_variable() noexcept = default;
+
+    CORO_NO_COPY_MOVE(condition_variable);
+
+    /**
+     * @brief 释放mtx并挂起, 被唤醒后重新获取mtx
+     *
+     * @note 调用前必须持有mtx, 与std::condition_variable一样可能出现虚假唤醒
+     */
+    auto wait(mutex& mtx) noexcept -> task<>;
+
+    /**
+     * @brief 等待直到pred()为true, pred在持有mtx时调用
+     */
+    template<typename predicate>
+    auto wait(mutex& mtx, predicate pred) noexcept -> task<>
+    {
+        while (!pred())
+        {
+            co_await wait(mtx);
+        }
+    }
+
+    /**
+     * @brief 唤醒最早等待的一个协程
+     */
+    auto notify_one() noexcept -> void;
+
+    /**
+     * @brief 唤醒全部等待的协程
+     */
+    auto notify_all() noexcept -> void;
+
+private:
+    std::mutex m_mtx;           // 只保护等待者队列
+    awaiter*   m_head{nullptr}; // 等待者队列, FIFO
+    awaiter*   m_tail{nullptr};
+};
+
+}; // namespace coro
@@ -38,6 +38,7 @@ public:
         event_base&             m_ev;
         awaiter_base*           m_next{nullptr};
         std::coroutine_handle<> m_await_coro{nullptr};
+        task_priority           m_prio{task_priority::normal};
     };
 
     event_base(bool initial_set = false) noexcept : m_state((initial_set) ? this : nullptr) {}
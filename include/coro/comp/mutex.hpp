@@ -0,0 +1,128 @@
+/**
+* @file mutex.hpp
+* @author daguai
+* @version 1.0
+*/
+#pragma once
+
+#include <atomic>
+#include <coroutine>
+
+#include "coro/attribute.hpp"
+#include "coro/detail/types.hpp"
+
+namespace coro
+{
+class context;
+using detail::awaiter_ptr;
+
+class mutex;
+
+/**
+ * @brief 持有mutex的RAII对象, 析构时释放锁
+ */
+class mutex_guard
+{
+public:
+    explicit mutex_guard(mutex& mtx) noexcept : m_mtx(&mtx) {}
+
+    mutex_guard(mutex_guard&& other) noexcept : m_mtx(other.m_mtx) { other.m_mtx = nullptr; }
+
+    mutex_guard(const mutex_guard&)            = delete;
+    mutex_guard& operator=(const mutex_guard&) = delete;
+    mutex_guard& operator=(mutex_guard&&)      = delete;
+
+    ~mutex_guard() noexcept { unlock(); }
+
+    /**
+     * @brief 提前释放锁, 重复调用无效果
+     */
+    auto unlock() noexcept -> void;
+
+private:
+    mutex* m_mtx;
+};
+
+/**
+ * @brief 协程互斥锁, 竞争时挂起协程而不是阻塞工作线程
+ *
+ * m_state有三种状态: this表示未上锁, nullptr表示已上锁且没有等待者, 其余值为等待者栈的栈顶.
+ * 等待者通过CAS压栈, unlock时把栈翻转为FIFO队列, 锁的所有权直接移交给队首的等待者,
+ * 等待者在自己的context上恢复执行.
+ */
+class mutex
+{
+public:
+    struct [[CORO_AWAIT_HINT]] lock_awaiter
+    {
+        lock_awaiter(context& ctx, mutex& mtx) noexcept : m_ctx(ctx), m_mtx(mtx) {}
+
+        auto await_ready() noexcept -> bool { return m_mtx.try_lock(); }
+
+        auto await_suspend(std::coroutine_handle<> handle) noexcept -> bool;
+
+        auto await_resume() noexcept -> void;
+
+        /**
+         * @brief 锁已经移交给该等待者, 在其所属的context上恢复
+         */
+        auto resume() noexcept -> void;
+
+        context&                m_ctx;                                 // 等待者所在的context
+        mutex&                  m_mtx;                                 // 关联的mutex
+        lock_awaiter*           m_next{nullptr};                       // 链表next
+        std::coroutine_handle<> m_await_coro{nullptr};                 // 恢复用的协程句柄
+        detail::task_priority   m_prio{detail::task_priority::normal}; // 等待者的优先级, 挂起时记录
+    };
+
+    struct [[CORO_AWAIT_HINT]] scoped_lock_awaiter : public lock_awaiter
+    {
+        using lock_awaiter::lock_awaiter;
+
+        auto await_resume() noexcept -> mutex_guard
+        {
+            lock_awaiter::await_resume();
+            return mutex_guard(m_mtx);
+        }
+    };
+
+    mutex() noexcept : m_state(unlocked_state()) {}
+    ~mutex() noexcept = default;
+
+    CORO_NO_COPY_MOVE(mutex);
+
+    /**
+     * @brief 尝试上锁, 不会挂起
+     */
+    auto try_lock() noexcept -> bool;
+
+    auto lock() noexcept -> lock_awaiter;
+
+    /**
+     * @brief 上锁并返回mutex_guard, 用法: auto guard = co_await mtx.scoped_lock();
+     */
+    auto scoped_lock() noexcept -> scoped_lock_awaiter;
+
+    /**
+     * @brief 释放锁, 有等待者时按FIFO顺序把锁直接移交给下一个等待者
+     */
+    auto unlock() noexcept -> void;
+
+private:
+    inline auto unlocked_state() noexcept -> awaiter_ptr { return this; }
+
+private:
+    std::atomic<awaiter_ptr> m_state;                    // 锁状态或等待者栈的栈顶
+    lock_awaiter*            m_resume_list_head{nullptr}; // FIFO顺序的等待者, 只由持锁者访问
+};
+
+inline auto mutex_guard::unlock() noexcept -> void
+{
+    if (m_mtx != nullptr)
+    {
+        m_mtx->unlock();
+        m_mtx = nullptr;
+    }
+}
+
+}; // namespace coro
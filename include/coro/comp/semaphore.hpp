@@ -0,0 +1,85 @@
+/**
+* @file semaphore.hpp
+* @author daguai
+* @version 1.0
+*/
+#pragma once
+
+#include <atomic>
+#include <coroutine>
+#include <cstdint>
+#include <mutex>
+
+#include "coro/attribute.hpp"
+#include "coro/detail/types.hpp"
+
+namespace coro
+{
+class context;
+
+/**
+ * @brief 协程计数信号量, 用于限制并发数
+ *
+ * m_count为正数时表示可用的许可数, 为负数时其绝对值为已经登记(或正在登记)的等待者数.
+ * 没有竞争时acquire与release都只是一次原子加减, 不会进入慢路径.
+ * 出现等待者时由m_mtx保护的FIFO队列按登记顺序移交许可, 释放时等待者尚未入队的许可记在m_pending中,
+ * 由该等待者入队前取走.
+ */
+class counting_semaphore
+{
+public:
+    struct [[CORO_AWAIT_HINT]] acquire_awaiter
+    {
+        acquire_awaiter(context& ctx, counting_semaphore& sem) noexcept : m_ctx(ctx), m_sem(sem) {}
+
+        /**
+         * @brief 预先占用一个许可, 没有可用许可时进入await_suspend等待移交
+         */
+        auto await_ready() noexcept -> bool { return m_sem.m_count.fetch_sub(1, std::memory_order_acq_rel) > 0; }
+
+        auto await_suspend(std::coroutine_handle<> handle) noexcept -> bool;
+
+        auto await_resume() noexcept -> void;
+
+        context&                m_ctx;                                 // 等待者所在的context
+        counting_semaphore&     m_sem;                                 // 关联的信号量
+        acquire_awaiter*        m_next{nullptr};                       // 链表next
+        std::coroutine_handle<> m_await_coro{nullptr};                 // 恢复用的协程句柄, 只在挂起时设置
+        detail::task_priority   m_prio{detail::task_priority::normal}; // 等待者的优先级, 挂起时记录
+    };
+
+    explicit counting_semaphore(int64_t desired) noexcept : m_count(desired) {}
+    ~counting_semaphore() noexcept = default;
+
+    CORO_NO_COPY_MOVE(counting_semaphore);
+
+    /**
+     * @brief 尝试获取一个许可, 不会挂起, 有等待者时不会插队
+     */
+    auto try_acquire() noexcept -> bool;
+
+    auto acquire() noexcept -> acquire_awaiter;
+
+    /**
+     * @brief 归还update个许可, 有等待者时按FIFO顺序直接移交
+     */
+    auto release(int64_t update = 1) noexcept -> void;
+
+    /**
+     * @brief 当前可用的许可数, 有等待者时为0
+     */
+    inline auto available() const noexcept -> int64_t
+    {
+        auto count = m_count.load(std::memory_order_acquire);
+        return count > 0 ? count : 0;
+    }
+
+private:
+    std::atomic<int64_t> m_count;
+    std::mutex           m_mtx;           // 只保护下面的等待队列与m_pending
+    acquire_awaiter*     m_head{nullptr}; // 等待者队列, FIFO
+    acquire_awaiter*     m_tail{nullptr};
+    int64_t              m_pending{0};    // 已经移交但等待者尚未入队的许可数
+};
+
+}; // namespace coro
@@ -0,0 +1,114 @@
+/**
+* @file shared_mutex.hpp
+* @author daguai
+* @version 1.0
+*/
+#pragma once
+
+#include <atomic>
+#include <coroutine>
+#include <cstdint>
+#include <mutex>
+
+#include "coro/attribute.hpp"
+#include "coro/detail/types.hpp"
+
+namespace coro
+{
+class context;
+
+/**
+ * @brief 协程读写锁, 写者优先
+ *
+ * m_state的低位为持有读锁的协程数, 最高位表示写锁被持有, 次高位表示有写者在等待.
+ * 没有写者持锁或等待时, lock_shared只需要对m_state做一次CAS, 不会进入慢路径.
+ * 慢路径的等待队列由m_mtx保护, 临界区只有链表操作, 协程的挂起与恢复都在锁外完成.
+ * 有写者等待时新的读者会排队, 写锁释放时优先移交给下一个写者, 没有写者时唤醒全部读者.
+ */
+class shared_mutex
+{
+public:
+    struct awaiter_base
+    {
+        awaiter_base(context& ctx, shared_mutex& mtx) noexcept : m_ctx(ctx), m_mtx(mtx) {}
+
+        auto await_resume() noexcept -> void;
+
+        /**
+         * @brief 锁已经移交给该等待者, 在其所属的context上恢复
+         */
+        auto resume() noexcept -> void;
+
+        context&                m_ctx;                                 // 等待者所在的context
+        shared_mutex&           m_mtx;                                 // 关联的shared_mutex
+        awaiter_base*           m_next{nullptr};                       // 链表next
+        std::coroutine_handle<> m_await_coro{nullptr};                 // 恢复用的协程句柄
+        detail::task_priority   m_prio{detail::task_priority::normal}; // 等待者的优先级, 挂起时记录
+    };
+
+    struct [[CORO_AWAIT_HINT]] lock_awaiter : public awaiter_base
+    {
+        using awaiter_base::awaiter_base;
+
+        auto await_ready() noexcept -> bool { return m_mtx.try_lock(); }
+
+        auto await_suspend(std::coroutine_handle<> handle) noexcept -> bool;
+    };
+
+    struct [[CORO_AWAIT_HINT]] lock_shared_awaiter : public awaiter_base
+    {
+        using awaiter_base::awaiter_base;
+
+        auto await_ready() noexcept -> bool { return m_mtx.try_lock_shared(); }
+
+        auto await_suspend(std::coroutine_handle<> handle) noexcept -> bool;
+    };
+
+    shared_mutex() noexcept  = default;
+    ~shared_mutex() noexcept = default;
+
+    CORO_NO_COPY_MOVE(shared_mutex);
+
+    /**
+     * @brief 尝试获取写锁, 不会挂起
+     */
+    auto try_lock() noexcept -> bool;
+
+    /**
+     * @brief 尝试获取读锁, 不会挂起, 有写者持锁或等待时失败
+     */
+    auto try_lock_shared() noexcept -> bool;
+
+    auto lock() noexcept -> lock_awaiter;
+
+    auto lock_shared() noexcept -> lock_shared_awaiter;
+
+    auto unlock() noexcept -> void;
+
+    auto unlock_shared() noexcept -> void;
+
+private:
+    static constexpr uint64_t kWriterBit  = uint64_t(1) << 63; // 写锁被持有
+    static constexpr uint64_t kWaitingBit = uint64_t(1) << 62; // 有写者在等待
+    static constexpr uint64_t kReaderMask = kWaitingBit - 1;   // 持有读锁的协程数
+
+    /**
+     * @brief 在m_mtx保护下把等待者追加到队列尾部
+     */
+    static auto push_back(awaiter_base*& head, awaiter_base*& tail, awaiter_base* waiter) noexcept -> void;
+
+    /**
+     * @brief 在m_mtx保护下取出队首的写者并把写锁移交给它, 调用者负责在锁外恢复
+     */
+    auto pop_writer() noexcept -> awaiter_base*;
+
+private:
+    std::atomic<uint64_t> m_state{0};
+    std::mutex            m_mtx;                  // 只保护下面的等待队列
+    awaiter_base*         m_writer_head{nullptr}; // 等待中的写者, FIFO
+    awaiter_base*         m_writer_tail{nullptr};
+    awaiter_base*         m_reader_head{nullptr}; // 等待中的读者, FIFO
+    awaiter_base*         m_reader_tail{nullptr};
+};
+
+}; // namespace coro
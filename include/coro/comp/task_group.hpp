@@ -0,0 +1,193 @@
+/**
+* @file task_group.hpp
+* @author daguai
+* @version 1.0
+*/
+#pragma once
+
+#include <atomic>
+#include <cassert>
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <stop_token>
+#include <utility>
+#include <vector>
+
+#include "coro/attribute.hpp"
+#include "coro/context.hpp"
+#include "coro/detail/resume_batch.hpp"
+#include "coro/scheduler.hpp"
+#include "coro/task.hpp"
+
+namespace coro
+{
+/**
+ * @brief 结构化并发的任务组, 子任务的生命周期不会超过任务组
+ *
+ * 用法:
+ *   task_group group;
+ *   group.spawn(handle_conn(conn, group.get_stop_token()));
+ *   co_await group.wait();
+ *
+ * 子任务的协程帧由任务组持有, 在wait()返回或任务组析构时统一销毁. 第一个抛出异常的子任务会通过stop_source
+ * 请求取消其余子任务, 该异常在wait()处重新抛出. 取消是协作式的, 子任务需要自行观察stop_token.
+ *
+ * wait()返回后任务组可以继续spawn下一轮子任务, 上一轮的取消请求与失败不会影响下一轮,
+ * 但上一轮通过get_stop_token()取得的stop_token不会观察到下一轮的取消.
+ *
+ * @note 必须在context中构造, spawn与wait只能由构造任务组的协程调用, 析构前必须co_await wait()
+ */
+class task_group : public detail::task_notifier
+{
+public:
+    struct [[CORO_AWAIT_HINT]] awaiter
+    {
+        explicit awaiter(task_group& group) noexcept : m_group(group) {}
+
+        auto await_ready() noexcept -> bool { return m_group.m_count.load(std::memory_order_acquire) == 1; }
+
+        auto await_suspend(std::coroutine_handle<> handle) noexcept -> bool
+        {
+            m_group.m_await_coro = handle;
+            m_group.m_prio       = linfo.prio;
+            m_group.m_ctx.register_wait();
+            // 撤销等待者自己持有的一份计数, 子任务已经全部结束时不需要挂起
+            if (m_group.m_count.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            {
+                m_group.m_ctx.unregister_wait();
+                m_group.m_await_coro = nullptr;
+                return false;
+            }
+            return true;
+        }
+
+        /**
+         * @brief 第一个失败的子任务的异常在此重新抛出
+         */
+        auto await_resume() -> void
+        {
+            if (m_group.m_await_coro != nullptr)
+            {
+                m_group.m_ctx.unregister_wait();
+                m_group.m_await_coro = nullptr;
+            }
+            // 子任务已经全部结束, 重置任务组的状态使其可以继续使用
+            m_group.reset();
+            if (m_group.m_exception_ptr)
+            {
+                std::rethrow_exception(std::exchange(m_group.m_exception_ptr, nullptr));
+            }
+        }
+
+        task_group& m_group;
+    };
+
+    task_group() noexcept : m_ctx(local_context()) {}
+
+    CORO_NO_COPY_MOVE(task_group);
+
+    ~task_group()
+    {
+        assert(m_count.load(std::memory_order_acquire) == 1 && "task_group destroyed before wait()");
+    }
+
+    /**
+     * @brief 启动子任务, 由scheduler分发到某个context上执行, 子任务继承调用者的优先级
+     */
+    auto spawn(task<>&& t) noexcept -> void
+    {
+        auto handle = prepare(std::move(t));
+        if (handle != nullptr)
+        {
+            scheduler::submit(handle, linfo.prio);
+        }
+    }
+
+    /**
+     * @brief 在指定的context上启动子任务, 子任务继承调用者的优先级
+     */
+    auto spawn(task<>&& t, size_t ctx_id) noexcept -> void
+    {
+        auto handle = prepare(std::move(t));
+        if (handle != nullptr)
+        {
+            scheduler::submit(handle, ctx_id, linfo.prio);
+        }
+    }
+
+    /**
+     * @brief 等待全部子任务结束, 用法: co_await group.wait();
+     */
+    auto wait() noexcept -> awaiter { return awaiter(*this); }
+
+    /**
+     * @brief 子任务用于观察取消请求的stop_token
+     */
+    inline auto get_stop_token() const noexcept -> std::stop_token { return m_stop.get_token(); }
+
+    /**
+     * @brief 请求取消全部子任务
+     */
+    inline auto request_stop() noexcept -> bool { return m_stop.request_stop(); }
+
+    auto on_task_done(std::coroutine_handle<> handle) noexcept -> std::coroutine_handle<> override
+    {
+        try
+        {
+            task<>::coroutine_handle::from_address(handle.address()).promise().result();
+        }
+        catch (...)
+        {
+            // 只记录第一个异常, m_exception_ptr通过m_count的acq_rel对等待者可见
+            if (!m_failed.exchange(true, std::memory_order_relaxed))
+            {
+                m_exception_ptr = std::current_exception();
+                m_stop.request_stop();
+            }
+        }
+
+        if (m_count.fetch_sub(1, std::memory_order_acq_rel) != 1)
+        {
+            return std::noop_coroutine();
+        }
+        return detail::resume_waiter(m_ctx, m_await_coro, m_prio);
+    }
+
+private:
+    /**
+     * @brief 子任务全部结束后由等待者调用, 释放子任务的协程帧并恢复计数、失败标记与stop_source,
+     * 第一个异常保留到await_resume重新抛出
+     */
+    auto reset() noexcept -> void
+    {
+        m_tasks.clear();
+        m_stop = std::stop_source{};
+        m_failed.store(false, std::memory_order_relaxed);
+        m_count.store(1, std::memory_order_relaxed);
+    }
+
+    auto prepare(task<>&& t) noexcept -> std::coroutine_handle<>
+    {
+        auto handle = t.handle();
+        if (handle == nullptr || handle.done())
+        {
+            return nullptr;
+        }
+        handle.promise().notifier(this);
+        m_count.fetch_add(1, std::memory_order_relaxed);
+        m_tasks.push_back(std::move(t));
+        return handle;
+    }
+
+    context&                       m_ctx;                         // 等待者所在的context
+    CORO_ALIGN std::atomic<size_t> m_count{1};                    // 未结束的子任务数加一, 多出的一份由等待者持有
+    std::coroutine_handle<>        m_await_coro{nullptr};         // 恢复用的协程句柄, 只在挂起时设置
+    task_priority                  m_prio{task_priority::normal}; // 等待者的优先级, 只在挂起时设置
+    std::stop_source               m_stop;                        // 取消子任务用
+    std::atomic<bool>              m_failed{false};               // 是否已有子任务失败
+    std::exception_ptr             m_exception_ptr{nullptr};      // 第一个失败的子任务的异常
+    std::vector<task<>>            m_tasks;                       // 持有子任务的协程帧
+};
+
+}; // namespace coro
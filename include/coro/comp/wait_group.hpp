@@ -29,12 +29,11 @@ public:
 
         auto await_resume() noexcept -> void;
 
-        auto resume() noexcept -> void;
-
-        context&                m_ctx; // 等待者所在的context
-        wait_group&             m_wg;  // 关联的wait_group
-        awaiter*                m_next{nullptr}; // 链表next
-        std::coroutine_handle<> m_await_coro{nullptr}; // 恢复用的协程句柄
+        context&                m_ctx;                                 // 等待者所在的context
+        wait_group&             m_wg;                                  // 关联的wait_group
+        awaiter*                m_next{nullptr};                       // 链表next
+        std::coroutine_handle<> m_await_coro{nullptr};                 // 恢复用的协程句柄
+        detail::task_priority   m_prio{detail::task_priority::normal}; // 等待者的优先级, 挂起时记录
     };
 
     explicit wait_group(int count = 0) noexcept : m_count(count) {}
@@ -48,7 +47,7 @@ public:
 private:
     friend awaiter;
     std::atomic<int32_t>     m_count; // 剩余任务数
-    std::atomic<awaiter_ptr> m_state; // 等待者链表的头指针
+    std::atomic<awaiter_ptr> m_state{nullptr}; // 等待者链表的头指针
 };
 
 }; // namespace coro
@@ -0,0 +1,281 @@
+/**
+* @file when_all.hpp
+* @author daguai
+* @version 1.0
+*/
+#pragma once
+
+#include <atomic>
+#include <cassert>
+#include <coroutine>
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include "coro/attribute.hpp"
+#include "coro/context.hpp"
+#include "coro/detail/resume_batch.hpp"
+#include "coro/scheduler.hpp"
+#include "coro/task.hpp"
+
+namespace coro
+{
+/**
+ * @brief 组合器的启动方式标记, 传入时子任务从等待者的下一个context开始依次分发到scheduler的各个context,
+ *        否则在当前context上依次启动
+ */
+struct spread_t
+{
+    explicit constexpr spread_t() noexcept = default;
+};
+
+inline constexpr spread_t spread{};
+
+namespace detail
+{
+template<typename return_type>
+using when_result_t = std::conditional_t<std::is_void_v<return_type>, std::monostate, return_type>;
+
+/**
+ * @brief 取出已结束子任务的结果, 子任务抛出的异常在此重新抛出
+ */
+template<typename return_type>
+auto take_result(task<return_type>& t) -> when_result_t<return_type>
+{
+    if constexpr (std::is_void_v<return_type>)
+    {
+        t.promise().result();
+        return std::monostate{};
+    }
+    else
+    {
+        return std::move(t).promise().result();
+    }
+}
+
+/**
+ * @brief when_all/when_any的公共部分
+ *
+ * 子任务的协程帧与结果都保存在组合器自身(即等待者的协程帧)中, 组合器通过promise中的notifier
+ * 得知子任务结束, 不需要额外的包装协程. 变参形式不做任何堆分配; 范围形式按值持有传入的std::vector,
+ * when_all的范围形式还会分配一个存放结果的std::vector. m_count初始为子任务数加一, 多出的一份由等待者
+ * 在启动全部子任务后撤销, 计数归零的一方负责恢复等待者.
+ */
+class when_base : public task_notifier
+{
+public:
+    explicit when_base(size_t num, bool spread) noexcept
+        : m_ctx(local_context()),
+          m_count(num + 1),
+          m_spread(spread)
+    {
+    }
+
+    CORO_NO_COPY_MOVE(when_base);
+
+    auto on_task_done([[CORO_MAYBE_UNUSED]] std::coroutine_handle<> handle) noexcept
+        -> std::coroutine_handle<> override
+    {
+        if (m_count.fetch_sub(1, std::memory_order_acq_rel) != 1)
+        {
+            return std::noop_coroutine();
+        }
+        return resume_waiter(m_ctx, m_await_coro, m_prio);
+    }
+
+protected:
+    ~when_base() = default;
+
+    auto begin_suspend(std::coroutine_handle<> handle) noexcept -> void
+    {
+        m_await_coro = handle;
+        m_prio       = linfo.prio;
+        m_ctx.register_wait();
+    }
+
+    template<typename return_type>
+    auto start(task<return_type>& t) noexcept -> void
+    {
+        auto handle = t.handle();
+        assert(handle != nullptr && "when_all/when_any get an empty task");
+        if (handle == nullptr)
+        {
+            m_count.fetch_sub(1, std::memory_order_acq_rel);
+            return;
+        }
+        if (handle.done())
+        {
+            // 已经结束的子任务按正常结束处理, when_any可以由它产生胜者.
+            // 等待者持有的一份计数尚未撤销, 因此这里不会返回等待者
+            [[CORO_MAYBE_UNUSED]] auto next = on_task_done(handle);
+            return;
+        }
+        handle.promise().notifier(this);
+        if (m_spread)
+        {
+            // 子任务继承等待者的优先级
+            scheduler::submit(handle, (m_ctx.get_index() + (++m_started)) % scheduler::context_count(), m_prio);
+        }
+        else
+        {
+            handle.resume();
+        }
+    }
+
+    /**
+     * @brief 全部子任务启动后调用
+     *
+     * @return 是否需要挂起, 子任务已经全部结束时返回false
+     */
+    auto end_suspend() noexcept -> bool
+    {
+        if (m_count.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        {
+            m_ctx.unregister_wait();
+            m_await_coro = nullptr;
+            return false;
+        }
+        return true;
+    }
+
+    auto end_wait() noexcept -> void
+    {
+        if (m_await_coro != nullptr)
+        {
+            m_ctx.unregister_wait();
+        }
+    }
+
+    context&                m_ctx;                         // 等待者所在的context
+    std::atomic<size_t>     m_count;                       // 尚未结束的子任务数加一
+    std::coroutine_handle<> m_await_coro{nullptr};         // 恢复用的协程句柄, 只在挂起时设置
+    task_priority           m_prio{task_priority::normal}; // 等待者的优先级, 只在挂起时设置
+    bool                    m_spread;                      // 是否把子任务分发到各个context
+    size_t                  m_started{0};                  // 已分发的子任务数
+};
+
+template<typename... return_types>
+class [[CORO_AWAIT_HINT]] when_all_awaiter : public when_base
+{
+public:
+    using result_type = std::tuple<when_result_t<return_types>...>;
+
+    explicit when_all_awaiter(bool spread, task<return_types>&&... tasks) noexcept
+        : when_base(sizeof...(return_types), spread),
+          m_tasks(std::move(tasks)...)
+    {
+    }
+
+    constexpr auto await_ready() noexcept -> bool { return sizeof...(return_types) == 0; }
+
+    auto await_suspend(std::coroutine_handle<> handle) noexcept -> bool
+    {
+        begin_suspend(handle);
+        std::apply([this](auto&... t) { (start(t), ...); }, m_tasks);
+        return end_suspend();
+    }
+
+    /**
+     * @return 各子任务的结果, 返回void的子任务对应std::monostate
+     */
+    auto await_resume() -> result_type
+    {
+        end_wait();
+        return std::apply([](auto&... t) { return result_type(take_result(t)...); }, m_tasks);
+    }
+
+private:
+    std::tuple<task<return_types>...> m_tasks;
+};
+
+template<typename return_type>
+class [[CORO_AWAIT_HINT]] when_all_range_awaiter : public when_base
+{
+public:
+    using result_type = std::conditional_t<std::is_void_v<return_type>, void, std::vector<return_type>>;
+
+    explicit when_all_range_awaiter(bool spread, std::vector<task<return_type>>&& tasks) noexcept
+        : when_base(tasks.size(), spread),
+          m_tasks(std::move(tasks))
+    {
+    }
+
+    auto await_ready() noexcept -> bool { return m_tasks.empty(); }
+
+    auto await_suspend(std::coroutine_handle<> handle) noexcept -> bool
+    {
+        begin_suspend(handle);
+        for (auto& t : m_tasks)
+        {
+            start(t);
+        }
+        return end_suspend();
+    }
+
+    /**
+     * @return 按子任务顺序排列的结果, 子任务返回void时无返回值
+     */
+    auto await_resume() -> result_type
+    {
+        end_wait();
+        if constexpr (std::is_void_v<return_type>)
+        {
+            for (auto& t : m_tasks)
+            {
+                take_result(t);
+            }
+        }
+        else
+        {
+            std::vector<return_type> results;
+            results.reserve(m_tasks.size());
+            for (auto& t : m_tasks)
+            {
+                results.push_back(take_result(t));
+            }
+            return results;
+        }
+    }
+
+private:
+    std::vector<task<return_type>> m_tasks;
+};
+}; // namespace detail
+
+/**
+ * @brief 并发执行全部子任务, 全部结束后返回各自的结果, 用法: auto res = co_await when_all(t1(), t2());
+ */
+template<typename... return_types>
+auto when_all(task<return_types>&&... tasks) noexcept -> detail::when_all_awaiter<return_types...>
+{
+    return detail::when_all_awaiter<return_types...>(false, std::move(tasks)...);
+}
+
+/**
+ * @brief 同when_all, 子任务分发到scheduler的各个context上执行
+ */
+template<typename... return_types>
+auto when_all(spread_t, task<return_types>&&... tasks) noexcept -> detail::when_all_awaiter<return_types...>
+{
+    return detail::when_all_awaiter<return_types...>(true, std::move(tasks)...);
+}
+
+/**
+ * @brief 同when_all, 子任务数量在运行时确定, 结果按子任务顺序存放在新分配的std::vector中
+ */
+template<typename return_type>
+auto when_all(std::vector<task<return_type>> tasks) noexcept -> detail::when_all_range_awaiter<return_type>
+{
+    return detail::when_all_range_awaiter<return_type>(false, std::move(tasks));
+}
+
+template<typename return_type>
+auto when_all(spread_t, std::vector<task<return_type>> tasks) noexcept -> detail::when_all_range_awaiter<return_type>
+{
+    return detail::when_all_range_awaiter<return_type>(true, std::move(tasks));
+}
+
+}; // namespace coro
@@ -0,0 +1,308 @@
+/**
+* @file when_any.hpp
+* @author daguai
+* @version 1.0
+*/
+#pragma once
+
+#include <atomic>
+#include <cassert>
+#include <coroutine>
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <stop_token>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include "coro/attribute.hpp"
+#include "coro/comp/when_all.hpp"
+#include "coro/task.hpp"
+
+namespace coro
+{
+/**
+ * @brief when_any的取消标记, 传入时组合器自己持有stop_source, 子任务由接受std::stop_token的可调用对象创建
+ */
+struct cancel_losers_t
+{
+    explicit constexpr cancel_losers_t() noexcept = default;
+};
+
+inline constexpr cancel_losers_t cancel_losers{};
+
+namespace detail
+{
+/**
+ * @brief when_any的公共部分, 第一个结束的子任务成为胜者并通过stop_source请求取消其余子任务
+ *
+ * 子任务的协程帧保存在组合器中, 因此仍需等待落败的子任务全部结束后才恢复等待者,
+ * 即等待者的延迟由最慢的落败者决定而不是胜者. 取消是协作式的, 子任务需要自行观察stop_token并尽快返回,
+ * 不观察stop_token的落败者会一直运行到自然结束.
+ */
+class when_any_base : public when_base
+{
+public:
+    static constexpr size_t npos = std::numeric_limits<size_t>::max();
+
+    when_any_base(size_t num, bool spread, std::stop_source* stop) noexcept : when_base(num, spread), m_stop(stop) {}
+
+    auto on_task_done(std::coroutine_handle<> handle) noexcept -> std::coroutine_handle<> override
+    {
+        auto expected = npos;
+        if (m_winner.compare_exchange_strong(expected, task_index(handle), std::memory_order_acq_rel) &&
+            m_stop != nullptr)
+        {
+            m_stop->request_stop();
+        }
+        return when_base::on_task_done(handle);
+    }
+
+protected:
+    ~when_any_base() = default;
+
+    /**
+     * @brief 根据协程句柄查找子任务的下标
+     */
+    virtual auto task_index(std::coroutine_handle<> handle) noexcept -> size_t = 0;
+
+    std::stop_source*   m_stop;           // 胜者产生后请求停止, 可以为空
+    std::atomic<size_t> m_winner{npos};   // 胜者的下标
+};
+
+template<typename... return_types>
+class [[CORO_AWAIT_HINT]] when_any_awaiter : public when_any_base
+{
+    static_assert(sizeof...(return_types) > 0, "when_any requires at least one task");
+
+public:
+    using result_type = std::variant<when_result_t<return_types>...>;
+
+    when_any_awaiter(bool spread, std::stop_source* stop, task<return_types>&&... tasks) noexcept
+        : when_any_base(sizeof...(return_types), spread, stop),
+          m_tasks(std::move(tasks)...)
+    {
+    }
+
+    constexpr auto await_ready() noexcept -> bool { return false; }
+
+    auto await_suspend(std::coroutine_handle<> handle) noexcept -> bool
+    {
+        begin_suspend(handle);
+        std::apply([this](auto&... t) { (start(t), ...); }, m_tasks);
+        return end_suspend();
+    }
+
+    /**
+     * @return 胜者的结果, variant::index()即胜者的下标, 胜者抛出的异常在此重新抛出
+     */
+    auto await_resume() -> result_type
+    {
+        end_wait();
+        auto winner = m_winner.load(std::memory_order_acquire);
+        assert(winner != npos && "when_any resumed without a winner");
+        return take_winner(winner);
+    }
+
+protected:
+    auto task_index(std::coroutine_handle<> handle) noexcept -> size_t override
+    {
+        size_t index = npos;
+        size_t i     = 0;
+        std::apply(
+            [&](auto&... t) { ((index = (t.handle().address() == handle.address()) ? i : index, ++i), ...); },
+            m_tasks);
+        return index;
+    }
+
+private:
+    template<size_t I = 0>
+    auto take_winner(size_t winner) -> result_type
+    {
+        if constexpr (I + 1 < sizeof...(return_types))
+        {
+            if (winner != I)
+            {
+                return take_winner<I + 1>(winner);
+            }
+        }
+        return result_type(std::in_place_index<I>, take_result(std::get<I>(m_tasks)));
+    }
+
+    std::tuple<task<return_types>...> m_tasks;
+};
+
+template<typename return_type>
+class [[CORO_AWAIT_HINT]] when_any_range_awaiter : public when_any_base
+{
+public:
+    using result_type =
+        std::conditional_t<std::is_void_v<return_type>, size_t, std::pair<size_t, when_result_t<return_type>>>;
+
+    when_any_range_awaiter(bool spread, std::stop_source* stop, std::vector<task<return_type>>&& tasks) noexcept
+        : when_any_base(tasks.size(), spread, stop),
+          m_tasks(std::move(tasks))
+    {
+        assert(!m_tasks.empty() && "when_any requires at least one task");
+    }
+
+    constexpr auto await_ready() noexcept -> bool { return false; }
+
+    auto await_suspend(std::coroutine_handle<> handle) noexcept -> bool
+    {
+        begin_suspend(handle);
+        for (auto& t : m_tasks)
+        {
+            start(t);
+        }
+        return end_suspend();
+    }
+
+    /**
+     * @return 胜者的下标与结果, 子任务返回void时只返回下标
+     */
+    auto await_resume() -> result_type
+    {
+        end_wait();
+        auto winner = m_winner.load(std::memory_order_acquire);
+        assert(winner != npos && "when_any resumed without a winner");
+        if constexpr (std::is_void_v<return_type>)
+        {
+            take_result(m_tasks[winner]);
+            return winner;
+        }
+        else
+        {
+            return result_type(winner, take_result(m_tasks[winner]));
+        }
+    }
+
+protected:
+    auto task_index(std::coroutine_handle<> handle) noexcept -> size_t override
+    {
+        for (size_t i = 0; i < m_tasks.size(); i++)
+        {
+            if (m_tasks[i].handle().address() == handle.address())
+            {
+                return i;
+            }
+        }
+        return npos;
+    }
+
+private:
+    std::vector<task<return_type>> m_tasks;
+};
+
+template<typename task_type>
+struct task_return;
+
+template<typename return_type>
+struct task_return<task<return_type>>
+{
+    using type = return_type;
+};
+
+/**
+ * @brief 可调用对象以std::stop_token调用后返回的task的结果类型
+ */
+template<typename fn_type>
+using stop_fn_return_t = typename task_return<std::invoke_result_t<fn_type, std::stop_token>>::type;
+
+/**
+ * @brief 先于when_any_awaiter构造的stop_source, 使子任务在创建时就能取得stop_token
+ */
+struct owned_stop_source
+{
+    std::stop_source m_owned_stop;
+};
+
+template<typename... fn_types>
+class [[CORO_AWAIT_HINT]] when_any_cancel_awaiter : private owned_stop_source,
+                                                    public when_any_awaiter<stop_fn_return_t<fn_types>...>
+{
+public:
+    explicit when_any_cancel_awaiter(bool spread, fn_types&&... fns)
+        : owned_stop_source(),
+          when_any_awaiter<stop_fn_return_t<fn_types>...>(
+              spread, &m_owned_stop, std::invoke(std::forward<fn_types>(fns), m_owned_stop.get_token())...)
+    {
+    }
+};
+}; // namespace detail
+
+/**
+ * @brief 并发执行全部子任务, 返回最先结束的子任务的结果, 用法: auto res = co_await when_any(t1(), t2());
+ *
+ * @note 等待者在全部子任务结束后才恢复, 延迟由最慢的落败者决定. 落败的子任务会继续运行到结束,
+ *       需要提前取消时使用带stop_source或cancel_losers的重载
+ */
+template<typename... return_types>
+auto when_any(task<return_types>&&... tasks) noexcept -> detail::when_any_awaiter<return_types...>
+{
+    return detail::when_any_awaiter<return_types...>(false, nullptr, std::move(tasks)...);
+}
+
+/**
+ * @brief 同when_any, 胜者产生后对stop调用request_stop, 子任务应持有stop.get_token()并观察取消请求
+ */
+template<typename... return_types>
+auto when_any(std::stop_source& stop, task<return_types>&&... tasks) noexcept
+    -> detail::when_any_awaiter<return_types...>
+{
+    return detail::when_any_awaiter<return_types...>(false, &stop, std::move(tasks)...);
+}
+
+template<typename... return_types>
+auto when_any(spread_t, std::stop_source& stop, task<return_types>&&... tasks) noexcept
+    -> detail::when_any_awaiter<return_types...>
+{
+    return detail::when_any_awaiter<return_types...>(true, &stop, std::move(tasks)...);
+}
+
+/**
+ * @brief 同when_any, 由组合器持有stop_source, 每个可调用对象以其stop_token调用并返回子任务,
+ *        用法: co_await when_any(cancel_losers, [&](std::stop_token t) { return fetch(a, t); }, ...);
+ *
+ * @note stop_source的共享状态在构造组合器时分配在堆上, 每次调用一次分配; 需要避免该分配或在多次
+ *       调用间复用时, 使用传入stop_source的重载
+ */
+template<typename... fn_types>
+auto when_any(cancel_losers_t, fn_types&&... fns) -> detail::when_any_cancel_awaiter<fn_types...>
+{
+    return detail::when_any_cancel_awaiter<fn_types...>(false, std::forward<fn_types>(fns)...);
+}
+
+template<typename... fn_types>
+auto when_any(spread_t, cancel_losers_t, fn_types&&... fns) -> detail::when_any_cancel_awaiter<fn_types...>
+{
+    return detail::when_any_cancel_awaiter<fn_types...>(true, std::forward<fn_types>(fns)...);
+}
+
+/**
+ * @brief 同when_any, 子任务数量在运行时确定, 组合器按值持有传入的std::vector
+ */
+template<typename return_type>
+auto when_any(std::vector<task<return_type>> tasks) noexcept -> detail::when_any_range_awaiter<return_type>
+{
+    return detail::when_any_range_awaiter<return_type>(false, nullptr, std::move(tasks));
+}
+
+template<typename return_type>
+auto when_any(std::stop_source& stop, std::vector<task<return_type>> tasks) noexcept
+    -> detail::when_any_range_awaiter<return_type>
+{
+    return detail::when_any_range_awaiter<return_type>(false, &stop, std::move(tasks));
+}
+
+template<typename return_type>
+auto when_any(spread_t, std::stop_source& stop, std::vector<task<return_type>> tasks) noexcept
+    -> detail::when_any_range_awaiter<return_type>
+{
+    return detail::when_any_range_awaiter<return_type>(true, &stop, std::move(tasks));
+}
+
+}; // namespace coro
@@ -9,6 +9,7 @@
 #include "config.h"
 #include "coro/engine.hpp"
 #include "coro/meta_info.hpp"
+#include "coro/options.hpp"
 #include "coro/task.hpp"
 
 namespace coro
@@ -19,6 +20,7 @@ using std::make_unique;
 using std::memory_order_acq_rel;
 using std::memory_order_acquire;
 using std::memory_order_relaxed;
+using std::stop_source;
 using std::stop_token;
 using std::unique_ptr;
 using std::jthread;
@@ -26,7 +28,8 @@ using std::jthread;
 using detail::ginfo;
 using detail::linfo;
 
-using engine = detail::engine;
+using engine        = detail::engine;
+using task_priority = detail::task_priority;
 
 class scheduler;
 
@@ -35,7 +38,13 @@ class context
     using stop_cb = std::function<void()>;
 
 public:
-    context() noexcept;
+    explicit context(const engine_options& opts = engine_options{}) noexcept;
+
+    /**
+    * @brief 由scheduler调用, index为context在scheduler中的下标, context id仍然全局唯一
+    */
+    context(size_t index, const engine_options& opts) noexcept;
+
     ~context() noexcept                = default;
     context(const context&)            = delete;
     context(context&&)                 = delete;
@@ -47,6 +56,38 @@ public:
     */
     auto start() noexcept -> void;
 
+    /**
+    * @brief 设置工作线程绑定的CPU, 需要在start之前调用
+    *
+    * @param cpu 小于0表示不绑定
+    */
+    inline auto set_cpu(int cpu) noexcept -> void { m_cpu = cpu; }
+
+    /**
+    * @brief 获取工作线程绑定的CPU, 未绑定时返回-1
+    */
+    inline auto get_cpu() const noexcept -> int { return m_cpu; }
+
+    /**
+    * @brief 设置context所在的NUMA节点, dispatcher优先把工作线程上提交的任务分发到同一节点的context
+    */
+    inline auto set_node(int node) noexcept -> void { m_node = node; }
+
+    /**
+    * @brief 获取context所在的NUMA节点, 未绑定CPU时为0
+    */
+    inline auto get_node() const noexcept -> int { return m_node; }
+
+    /**
+    * @brief 设置context所属的scheduler, 工作线程上调用的scheduler静态接口作用于该scheduler
+    */
+    inline auto set_scheduler(scheduler* sched) noexcept -> void { m_sched = sched; }
+
+    /**
+    * @brief 获取context所属的scheduler, 独立使用的context返回nullptr
+    */
+    inline auto get_scheduler() const noexcept -> scheduler* { return m_sched; }
+
     /**
     * @brief 发送停止信号到工作线程
     */
@@ -68,11 +109,11 @@ public:
      * @brief 将task的生命周期交给engine去管理
      * @param task&&
      */
-    inline auto submit_task(task<void>&& task) noexcept -> void
+    inline auto submit_task(task<void>&& task, task_priority prio = task_priority::normal) noexcept -> void
     {
         auto handle = task.handle();
         task.detach();
-        this->submit_task(handle);
+        this->submit_task(handle, prio);
     }
 
     /**
@@ -84,9 +125,29 @@ public:
     /**
     * @brief 提交一个任务句柄到context
     */
-    inline auto submit_task(std::coroutine_handle<> handle) noexcept -> void
+    inline auto submit_task(std::coroutine_handle<> handle, task_priority prio = task_priority::normal) noexcept
+        -> void
+    {
+        m_engine.submit_task(handle, prio);
+    }
+
+    /**
+    * @brief 提交一个被唤醒的任务句柄, 唤醒者与等待者在同一context时优先执行该任务
+    */
+    inline auto submit_next(std::coroutine_handle<> handle, task_priority prio = task_priority::normal) noexcept
+        -> void
     {
-        m_engine.submit_task(handle);
+        m_engine.submit_next(handle, prio);
+    }
+
+    /**
+    * @brief 批量提交任务句柄到context, 只产生一次跨线程唤醒
+    */
+    inline auto
+    submit_batch(std::coroutine_handle<>* handles, size_t num, task_priority prio = task_priority::normal) noexcept
+        -> void
+    {
+        m_engine.submit_batch(handles, num, prio);
     }
 
     /**
@@ -96,6 +157,12 @@ public:
      */
     inline auto get_ctx_id() noexcept -> ctx_id { return m_id; }
 
+    /**
+     * @brief 获取context在所属scheduler中的下标, 用于向同一scheduler的context路由任务,
+     *        独立使用的context为0
+     */
+    inline auto get_index() const noexcept -> size_t { return m_index; }
+
     /**
     * @brief 添加context的任务计数
     *
@@ -147,10 +214,15 @@ public:
 
 private:
     CORO_ALIGN engine   m_engine; // 该context拥有的 engine
-    unique_ptr<jthread> m_job;  // 工作线程
+    stop_source         m_stop_source; // 工作线程的停止信号, 不经过m_job请求停止, 以免线程启动后访问到未赋值的m_job
+    unique_ptr<jthread> m_job;  // 工作线程, 声明在m_stop_source之后, 析构时先join线程再销毁m_stop_source
     ctx_id              m_id;    //唯一id
+    size_t              m_index{0}; // 在所属scheduler中的下标
     atomic<size_t>      m_num_wait_task{0}; // 等待中的任务数量(引用计数)
     stop_cb             m_stop_cb; // 停止时的回调函数
+    int                 m_cpu{-1};  // 工作线程绑定的CPU, 小于0表示不绑定
+    int                 m_node{0};  // 所在的NUMA节点
+    scheduler*          m_sched{nullptr}; // 所属的scheduler
 };
 
 inline context& local_context() noexcept
@@ -158,9 +230,9 @@ inline context& local_context() noexcept
     return *linfo.ctx;
 }
 
-inline void submit_to_context(task<void>&& task) noexcept
+inline void submit_to_context(task<void>&& task, task_priority prio = task_priority::normal) noexcept
 {
-    local_context().submit_task(std::move(task));
+    local_context().submit_task(std::move(task), prio);
 }
 
 inline void submit_to_context(task<void>& task) noexcept
@@ -168,9 +240,9 @@ inline void submit_to_context(task<void>& task) noexcept
     local_context().submit_task(task.handle());
 }
 
-inline void submit_to_context(std::coroutine_handle<> handle) noexcept
+inline void submit_to_context(std::coroutine_handle<> handle, task_priority prio = task_priority::normal) noexcept
 {
-    local_context().submit_task(handle);
+    local_context().submit_task(handle, prio);
 }
 
 
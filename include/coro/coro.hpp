@@ -1,14 +1,26 @@
 #pragma once
 //
-// #include "coro/comp/channel.hpp"
-// #include "coro/comp/condition_variable.hpp"
+#include "coro/comp/barrier.hpp"
+#include "coro/comp/channel.hpp"
+#include "coro/comp/condition_variable.hpp"
 // #include "coro/comp/latch.hpp"
-// #include "coro/comp/mutex.hpp"
+#include "coro/comp/mutex.hpp"
+#include "coro/comp/semaphore.hpp"
+#include "coro/comp/shared_mutex.hpp"
+#include "coro/comp/task_group.hpp"
 // #include "coro/comp/wait_group.hpp"
-// #include "coro/comp/when_all.hpp"
+#include "coro/comp/when_all.hpp"
+#include "coro/comp/when_any.hpp"
+#include "coro/async_generator.hpp"
+#include "coro/future.hpp"
+#include "coro/generator.hpp"
 #include "coro/io/net/tcp/tcp.hpp"
+#include "coro/io/net/udp/udp.hpp"
+#include "coro/io/net/uds/uds.hpp"
 // #include "coro/log.hpp"
-// #include "coro/parallel/parallel.hpp"
+#include "coro/parallel/parallel.hpp"
 #include "coro/scheduler.hpp"
+#include "coro/sharded.hpp"
 // #include "coro/timer.hpp"
 #include "coro/utils.hpp"
+#include "coro/yield.hpp"
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <exception>
+#include <new>
 #include <variant>
 #include <stdint.h>
 #include <stdexcept>
@@ -164,7 +165,7 @@ public:
         m_state = value_state::value;
     }
 
-    T result() noexcept
+    T result()
     {
         if (m_state == value_state::value)
         {
@@ -183,8 +184,9 @@ public:
 
     auto set_exception() noexcept -> void
     {
-        m_exception_ptr = std::current_exception();
-        m_state         = value_state::exception;
+        // union成员m_exception_ptr此前没有构造过, 不能直接赋值
+        new (&m_exception_ptr) std::exception_ptr(std::current_exception());
+        m_state = value_state::exception;
     }
 
     inline auto value_ready() noexcept -> bool { return m_state == value_state::value; }
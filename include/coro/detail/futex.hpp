@@ -0,0 +1,37 @@
+/**
+* @file futex.hpp
+* @author daguai
+* @version 1.0
+*/
+#pragma once
+
+#include <atomic>
+#include <climits>
+#include <cstdint>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace coro::detail
+{
+static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t), "futex word must be 32 bits");
+
+/**
+ * @brief 若futex字的值仍等于expected则阻塞当前线程, 直到被futex_wake唤醒
+ *
+ * @note 可能虚假唤醒, 调用者需要在循环中重新检查条件
+ */
+inline auto futex_wait(std::atomic<uint32_t>& word, uint32_t expected) noexcept -> void
+{
+    ::syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAIT_PRIVATE, expected, nullptr, nullptr, 0);
+}
+
+/**
+ * @brief 唤醒阻塞在futex字上的线程, 默认唤醒全部
+ */
+inline auto futex_wake(std::atomic<uint32_t>& word, int num = INT_MAX) noexcept -> void
+{
+    ::syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAKE_PRIVATE, num, nullptr, nullptr, 0);
+}
+
+}; // namespace coro::detail
@@ -0,0 +1,142 @@
+/**
+* @file resume_batch.hpp
+* @author daguai
+* @version 1.0
+*/
+#pragma once
+
+#include <array>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+
+#include "config.h"
+#include "coro/context.hpp"
+
+namespace coro::detail
+{
+/**
+ * @brief resume_grouped一次遍历中最多同时存在的分组数, 超出时先提交已有的分组
+ */
+inline constexpr size_t kResumeBucketNum = 64;
+
+/**
+ * @brief 按所属context与优先级分组恢复一条等待者链表, 每组通过submit_batch提交到该优先级的任务队列,
+ *        只唤醒一次目标线程
+ *
+ * awaiter_type需要提供 m_ctx, m_next, m_await_coro 与 m_prio 成员, m_prio为挂起时的linfo.prio,
+ * 因此等待者被唤醒后回到挂起前的优先级. 同一分组内保持链表中的相对顺序.
+ * 等待计数由awaiter的await_resume在所属线程上撤销, 这里只负责提交.
+ * 某个分组只有一个等待者时通过submit_next提交, 与唤醒者同在一个context时可以跳过任务队列.
+ *
+ * 只遍历一次链表, 按context指针与优先级散列到固定大小的分组表中, 通过m_next把同组的等待者重新串成链表,
+ * 因此复杂度与等待者数量成线性关系, 与涉及的context数量无关.
+ *
+ * @note 句柄提交后对应的协程可能立即在其他线程恢复并销毁awaiter, 因此提交前必须读完所需的成员
+ */
+template<typename awaiter_type>
+auto resume_grouped(awaiter_type* head) noexcept -> void
+{
+    struct bucket
+    {
+        context*      ctx{nullptr};
+        task_priority prio{task_priority::normal};
+        awaiter_type* head{nullptr};
+        awaiter_type* tail{nullptr};
+    };
+
+    std::array<bucket, kResumeBucketNum> buckets;
+    std::array<size_t, kResumeBucketNum> used; // 已使用的分组下标, 按首次出现的顺序
+    size_t                               num_used = 0;
+
+    auto flush = [&]() noexcept
+    {
+        std::array<std::coroutine_handle<>, config::kResumeBatchSize> batch;
+        for (size_t u = 0; u < num_used; u++)
+        {
+            auto&  bkt     = buckets[used[u]];
+            size_t num     = 0;
+            bool   flushed = false;
+            for (auto cur = bkt.head; cur != nullptr;)
+            {
+                // 先读出next再提交, 提交后不能再访问该awaiter
+                auto next    = cur->m_next;
+                batch[num++] = cur->m_await_coro;
+                if (num == batch.size())
+                {
+                    bkt.ctx->submit_batch(batch.data(), num, bkt.prio);
+                    num     = 0;
+                    flushed = true;
+                }
+                cur = next;
+            }
+            if (num == 1 && !flushed)
+            {
+                bkt.ctx->submit_next(batch[0], bkt.prio);
+            }
+            else if (num > 0)
+            {
+                bkt.ctx->submit_batch(batch.data(), num, bkt.prio);
+            }
+            bkt = bucket{};
+        }
+        num_used = 0;
+    };
+
+    while (head != nullptr)
+    {
+        auto cur = head;
+        head     = cur->m_next;
+
+        context*      ctx  = &cur->m_ctx;
+        task_priority prio = cur->m_prio;
+        size_t        idx =
+            (reinterpret_cast<uintptr_t>(ctx) / alignof(context) + static_cast<size_t>(prio)) % kResumeBucketNum;
+        while (buckets[idx].ctx != nullptr && (buckets[idx].ctx != ctx || buckets[idx].prio != prio))
+        {
+            idx = (idx + 1) % kResumeBucketNum;
+            if (num_used == kResumeBucketNum)
+            {
+                // 分组表已满, 先提交已有分组, 同一context中之后的等待者仍排在它们之后
+                flush();
+            }
+        }
+
+        auto& bkt   = buckets[idx];
+        cur->m_next = nullptr;
+        if (bkt.ctx == nullptr)
+        {
+            bkt.ctx          = ctx;
+            bkt.prio         = prio;
+            bkt.head         = cur;
+            used[num_used++] = idx;
+        }
+        else
+        {
+            bkt.tail->m_next = cur;
+        }
+        bkt.tail = cur;
+    }
+    flush();
+}
+
+/**
+ * @brief 最后一个子任务结束时恢复组合器的等待者, 在子任务的on_task_done中调用
+ *
+ * 与等待者在同一context时直接对称转移, 否则提交回等待者的context. 两种情况下等待者都以挂起时的优先级运行.
+ *
+ * @return 需要对称转移执行的协程句柄
+ */
+inline auto resume_waiter(context& ctx, std::coroutine_handle<> handle, task_priority prio) noexcept
+    -> std::coroutine_handle<>
+{
+    if (linfo.ctx == &ctx)
+    {
+        linfo.prio = prio;
+        return handle;
+    }
+    ctx.submit_task(handle, prio);
+    return std::noop_coroutine();
+}
+
+}; // namespace coro::detail
@@ -18,6 +18,17 @@ enum class dispatch_strategy : uint8_t
     none
 };
 
+/**
+ * @brief 任务优先级, 同一context中高优先级的任务先执行, none为优先级的数量
+ */
+enum class task_priority : uint8_t
+{
+    high,
+    normal, //NOTE: default
+    low,
+    none
+};
+
 
 using awaiter_ptr = void*;
 
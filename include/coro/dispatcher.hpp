@@ -1,12 +1,20 @@
 #pragma once
 
+#include <algorithm>
 #include <atomic>
+#include <deque>
 #include <memory>
 #include <vector>
 
+#include "coro/attribute.hpp"
 #include "coro/context.hpp"
 #include "coro/detail/types.hpp"
 
+namespace coro
+{
+class scheduler;
+};
+
 namespace coro::detail
 {
 using ctx_container = std::vector<std::unique_ptr<context>>;
@@ -16,7 +24,12 @@ class dispatcher
 {
 public:
 
-    void init([[CORO_MAYBE_UNUSED]] const size_t ctx_cnt, [[CORO_MAYBE_UNUSED]] ctx_container* ctxs) noexcept {}
+    void init(
+        [[CORO_MAYBE_UNUSED]] const size_t ctx_cnt,
+        [[CORO_MAYBE_UNUSED]] ctx_container* ctxs,
+        [[CORO_MAYBE_UNUSED]] scheduler*     owner) noexcept
+    {
+    }
 
     auto dispatch() noexcept -> size_t { return 0; }
 };
@@ -25,23 +38,68 @@ public:
 /**
 * @brief 采用round robin的方式将任务分发给context
 *
-* @tparam
+* context分布在多个NUMA节点上时, 本scheduler的工作线程提交的任务只在本节点的context之间轮转,
+* 避免子任务访问父任务数据时跨节点; 非工作线程与其他scheduler的工作线程提交的任务在全部context之间轮转
 */
 template<>
 class dispatcher<dispatch_strategy::round_robin>
 {
+    struct CORO_ALIGN node_ctxs
+    {
+        std::vector<size_t> ids;    // 节点上的context id
+        std::atomic<size_t> cur{0}; // 节点内的轮转位置
+    };
+
 public:
-    void init(size_t ctx_cnt, [[CORO_MAYBE_UNUSED]] ctx_container* ctxs) noexcept
+    /**
+     * @param owner 持有ctxs的scheduler, 用于判断提交任务的工作线程是否属于该scheduler
+     */
+    void init(size_t ctx_cnt, ctx_container* ctxs, scheduler* owner) noexcept
     {
+        m_owner   = owner;
         m_ctx_cnt = ctx_cnt;
         m_cur     = 0;
+        m_nodes.clear();
+        m_ctx_node.assign(ctx_cnt, 0);
+
+        int max_node = 0;
+        for (size_t i = 0; ctxs != nullptr && i < ctxs->size(); i++)
+        {
+            m_ctx_node[i] = std::max((*ctxs)[i]->get_node(), 0);
+            max_node      = std::max(max_node, m_ctx_node[i]);
+        }
+        if (max_node == 0)
+        {
+            return;
+        }
+        m_nodes.resize(max_node + 1);
+        for (size_t i = 0; i < ctx_cnt; i++)
+        {
+            m_nodes[m_ctx_node[i]].ids.push_back(i);
+        }
     }
 
-    auto dispatch() noexcept -> size_t { return m_cur.fetch_add(1,std::memory_order_acq_rel) % m_ctx_cnt; }
+    auto dispatch() noexcept -> size_t
+    {
+        // 其他scheduler的context下标与本scheduler无关, 不能用于查找节点
+        if (!m_nodes.empty() && is_in_working_state() && local_context().get_scheduler() == m_owner)
+        {
+            auto index = local_context().get_index();
+            if (index < m_ctx_cnt)
+            {
+                auto& node = m_nodes[m_ctx_node[index]];
+                return node.ids[node.cur.fetch_add(1, std::memory_order_relaxed) % node.ids.size()];
+            }
+        }
+        return m_cur.fetch_add(1, std::memory_order_acq_rel) % m_ctx_cnt;
+    }
     
 private:
-    size_t              m_ctx_cnt;
-    std::atomic<size_t> m_cur{0};
+    scheduler*            m_owner{nullptr};
+    size_t                m_ctx_cnt;
+    std::atomic<size_t>   m_cur{0};
+    std::vector<int>      m_ctx_node; // 每个context所在的NUMA节点
+    std::deque<node_ctxs> m_nodes;   // 按NUMA节点分组的context, 只有一个节点时为空
 };
 
 }; // namespace coro::detail 
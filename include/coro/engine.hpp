@@ -13,11 +13,14 @@
 #include <queue>
 #include <sys/types.h>
 #include <type_traits>
+#include <utility>
+#include <vector>
 
 #include "config.h"
 #include "coro/atomic_que.hpp"
 #include "coro/attribute.hpp"
 #include "coro/meta_info.hpp"
+#include "coro/options.hpp"
 #include "coro/uring_proxy.hpp"
 
 namespace coro 
@@ -34,6 +37,7 @@ using std::queue;
 using uring::urcptr;
 using uring::ursptr;
 using uring::uring_proxy;
+using ::coro::engine_options;
 
 inline engine& local_engine() noexcept;
 
@@ -56,7 +60,13 @@ public:
     static constexpr uint64_t task_flag = (((uint64_t)1) << 44);
     static constexpr uint64_t io_flag   = (((uint64_t)1) << 24);
 
-    engine() noexcept : m_num_io_wait_submit(0), m_num_io_running(0) 
+    static constexpr size_t priority_num = static_cast<size_t>(task_priority::none);
+
+    explicit engine(const engine_options& opts = engine_options{}) noexcept
+        : m_opts(opts),
+          m_task_queue(make_task_queues(opts, std::make_index_sequence<priority_num>{})),
+          m_num_io_wait_submit(0),
+          m_num_io_running(0)
     {
         m_id = ginfo.engine_id.fetch_add(1, std::memory_order_relaxed);
     }
@@ -78,35 +88,111 @@ public:
      *
      * @return true/false
      */
-    inline auto ready() noexcept -> bool { return !m_task_queue.was_empty(); }
+    inline auto ready() noexcept -> bool
+    {
+        if (m_next_task != nullptr)
+        {
+            return true;
+        }
+        for (auto& que : m_task_queue)
+        {
+            if (!que.was_empty())
+            {
+                return true;
+            }
+        }
+        return false;
+    }
 
     /**
-     * @brief 获取空闲sqe entry
+     * @brief 获取空闲sqe entry, 第一次调用时创建io_uring, SQ已满时先提交已有的SQE
      * 
      * @return ursptr
      */
-    [[CORO_DISCARD_HINT]] inline auto get_free_urs() noexcept -> ursptr { return m_upxy.get_free_sqe(); }
+    [[CORO_DISCARD_HINT]] inline auto get_free_urs() noexcept -> ursptr
+    {
+        if (!m_upxy.ring_ready()) [[unlikely]]
+        {
+            setup_ring();
+        }
+        auto sqe = m_upxy.get_free_sqe();
+        if (sqe == nullptr) [[unlikely]]
+        {
+            do_io_submit();
+            sqe = m_upxy.get_free_sqe();
+        }
+        return sqe;
+    }
 
     /**
      * @brief 获取在当前engine中正在运行的task
      * 
      * @return size_t
      */
-    inline auto num_task_schedule() noexcept -> size_t { return m_task_queue.was_size(); }
+    inline auto num_task_schedule() noexcept -> size_t
+    {
+        size_t num = 0;
+        for (auto& que : m_task_queue)
+        {
+            num += que.was_size();
+        }
+        return num;
+    }
+
+    /**
+     * @brief 获取指定优先级队列中的任务数量
+     */
+    inline auto num_task_schedule(task_priority prio) noexcept -> size_t
+    {
+        return m_task_queue[static_cast<size_t>(prio)].was_size();
+    }
 
     /**
-     * @brief 从任务队列取出一个协程句柄
+     * @brief 从优先级最高的非空任务队列取出一个协程句柄
      *
      * @return coroutine_handle
      */
     [[CORO_DISCARD_HINT]] auto schedule() noexcept -> coroutine_handle<>;
 
+    /**
+     * @brief 从指定优先级的任务队列取出一个协程句柄
+     *
+     * @return coroutine_handle
+     */
+    [[CORO_DISCARD_HINT]] auto schedule(task_priority prio) noexcept -> coroutine_handle<>;
+
     /**
      * @brief 提交一个task句柄到engine中
      *
      * @param handle
+     * @param prio 任务优先级
+     */
+    auto submit_task(coroutine_handle<> handle, task_priority prio = task_priority::normal) noexcept -> void;
+
+    /**
+     * @brief 批量提交task句柄, 全部入队后只唤醒一次工作线程
+     *
+     * @param handles
+     * @param num
+     * @param prio 全部句柄的优先级
+     */
+    auto submit_batch(coroutine_handle<>* handles, size_t num, task_priority prio = task_priority::normal) noexcept
+        -> void;
+
+    /**
+     * @brief 提交一个被唤醒的task句柄, lifo策略下若调用者运行在该engine上则放入next slot,
+     *        slot中原有的句柄转入其优先级的任务队列, 否则等同于submit_task
+     *
+     * @param handle
+     * @param prio 等待者的优先级, 与句柄一起保存在next slot中
+     */
+    auto submit_next(coroutine_handle<> handle, task_priority prio = task_priority::normal) noexcept -> void;
+
+    /**
+     * @brief 执行next slot中的任务, 执行期间linfo.prio为该任务的优先级,
+     *        连续执行超过 config::kLifoSlotBudget 次后放回任务队列
      */
-    auto submit_task(coroutine_handle<> handle) noexcept -> void;
+    auto exec_next_task() noexcept -> void;
 
     /**
      * @brief 调用 schedule() 取出一个任务并执行 
@@ -115,6 +201,11 @@ public:
      */
     auto exec_one_task() noexcept -> void;
 
+    /**
+     * @brief 从指定优先级的任务队列取出一个任务并执行, 执行期间linfo.prio为该优先级
+     */
+    auto exec_one_task(task_priority prio) noexcept -> void;
+
     /**
      * @brief 处理单个io_uring完成事件(CQE)
      *
@@ -127,6 +218,11 @@ public:
      */
     auto poll_submit() noexcept -> void;
 
+    /**
+     * @brief 提交SQE并处理已经完成的CQE, 不阻塞, 用于任务队列非空时保证IO完成能及时得到处理
+     */
+    auto poll_ready() noexcept -> void;
+
     /**
      * @brief 唤醒因读取eventfd而阻塞的线程
      */
@@ -154,18 +250,68 @@ public:
      inline auto get_id() noexcept -> uint32_t { return m_id; }
 
     /**
-     * @brief 返回 uring_proxy 引用
+     * @brief 返回 uring_proxy 引用, io_uring尚未创建时先创建
      *
      * @return uring_proxy&
      */
-    inline auto get_uring() noexcept -> uring_proxy& { return m_upxy;}
+    inline auto get_uring() noexcept -> uring_proxy&
+    {
+        if (!m_upxy.ring_ready()) [[unlikely]]
+        {
+            setup_ring();
+        }
+        return m_upxy;
+    }
+
+    /**
+     * @brief io_uring是否已经创建
+     */
+    inline auto ring_ready() const noexcept -> bool { return m_upxy.ring_ready(); }
+
+    /**
+     * @brief 设置ATTACH_WQ共享的io_uring描述符, 由同一scheduler的所有engine共用, 小于0表示尚未创建
+     *
+     * @note 需要在init之前调用
+     */
+    inline auto set_wq_anchor(atomic<int>* anchor) noexcept -> void { m_wq_anchor = anchor; }
+
+    /**
+     * @brief 返回创建engine时使用的参数
+     */
+    inline auto get_options() const noexcept -> const engine_options& { return m_opts; }
 
 private:
+    /**
+     * @brief 返回指定优先级任务队列的容量, 只有normal队列使用queue_cap
+     */
+    static constexpr auto queue_cap(const engine_options& opts, size_t prio) noexcept -> size_t
+    {
+        return prio == static_cast<size_t>(task_priority::normal) ? opts.queue_cap : opts.prio_queue_cap;
+    }
+
+    template<size_t... I>
+    static auto make_task_queues(const engine_options& opts, std::index_sequence<I...>) noexcept
+        -> array<mpmc_queue<coroutine_handle<>>, priority_num>
+    {
+        return {mpmc_queue<coroutine_handle<>>(queue_cap(opts, I))...};
+    }
+
+    /**
+     * @brief 创建io_uring, 开启attach_wq时与 m_wq_anchor 记录的io_uring共享io-wq线程池,
+     * 开启sqpoll时还需要开启attach_wq_sqpoll
+     */
+    auto setup_ring() noexcept -> void;
+
     /**
      * @brief 把 m_num_io_wait_submit 中记录的需要提交项写入 m_upxy 的SQE并调用submit
      */
     auto do_io_submit() noexcept -> void;
 
+    /**
+     * @brief 从CQ中批量取出已完成的CQE并调用 handle_cqe_entry
+     */
+    auto reap_cqe() noexcept -> void;
+
     /**
      * @brief resume协程执行 coroutine_handle的封装
      */
@@ -181,12 +327,18 @@ private:
     uint32_t    m_id;
     // io_uring instance
     uring_proxy m_upxy;
+    // 运行时参数
+    engine_options m_opts;
+
+    // 存储协程句柄, 每个优先级一个队列
+    array<mpmc_queue<coroutine_handle<>>, priority_num> m_task_queue;
 
-    // 存储协程句柄
-    mpmc_queue<coroutine_handle<>> m_task_queue;
+    // lifo策略下优先执行的句柄及其优先级, 只由工作线程访问
+    coroutine_handle<> m_next_task{nullptr};
+    task_priority      m_next_prio{task_priority::normal};
 
-    // 存储 CQE entry
-    array<urcptr, config::kQueCap> m_urc;
+    // 存储 CQE entry, 与io_uring一起创建, 容量与CQ相同
+    std::vector<urcptr> m_urc;
 
     /**
     * @note io_uring官方建议使用单线程， 所以任务的提交并不会夸线程, 无需使用atomic
@@ -201,6 +353,9 @@ private:
 
     // stack的递归深度
     size_t m_max_recursive_depth{0};
+
+    // 同一scheduler共享io-wq线程池的io_uring描述符
+    atomic<int>* m_wq_anchor{nullptr};
 };
 
 /**
@@ -0,0 +1,246 @@
+/**
+* @file future.hpp
+* @author daguai
+* @version 1.0
+*/
+#pragma once
+
+#include <atomic>
+#include <cassert>
+#include <coroutine>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <utility>
+
+#include "coro/attribute.hpp"
+#include "coro/context.hpp"
+#include "coro/detail/container.hpp"
+#include "coro/detail/futex.hpp"
+#include "coro/detail/types.hpp"
+#include "coro/task.hpp"
+
+namespace coro
+{
+namespace detail
+{
+/**
+ * @brief 等待future结果的协程
+ */
+struct future_waiter
+{
+    explicit future_waiter(context& ctx) noexcept : m_ctx(ctx) {}
+
+    context&                m_ctx;                         // 等待者所在的context
+    std::coroutine_handle<> m_await_coro{nullptr};         // 恢复用的协程句柄, 只在挂起时设置
+    task_priority           m_prio{task_priority::normal}; // 等待者的优先级, 只在挂起时设置
+};
+
+template<typename return_type>
+struct future_result : public container<return_type>
+{
+};
+
+template<>
+struct future_result<void>
+{
+    constexpr auto return_void() noexcept -> void {}
+
+    auto set_exception() noexcept -> void { m_exception_ptr = std::current_exception(); }
+
+    auto result() -> void
+    {
+        if (m_exception_ptr)
+        {
+            std::rethrow_exception(m_exception_ptr);
+        }
+    }
+
+private:
+    std::exception_ptr m_exception_ptr{nullptr};
+};
+
+/**
+ * @brief future的共享状态, 由future与产生结果的协程共同持有
+ *
+ * m_futex是阻塞线程使用的futex字, 只有存在阻塞的线程时set_ready才会进行futex_wake系统调用.
+ * m_waiter为nullptr表示没有等待的协程, this表示结果已就绪, 其余值为等待的协程.
+ */
+template<typename return_type>
+class future_state : public future_result<return_type>
+{
+public:
+    inline auto is_ready() const noexcept -> bool { return m_futex.load(std::memory_order_acquire) == kReady; }
+
+    /**
+     * @brief 结果写入后调用, 唤醒阻塞的线程与等待的协程
+     */
+    auto set_ready() noexcept -> void
+    {
+        if (m_futex.exchange(kReady, std::memory_order_acq_rel) == kSleeping)
+        {
+            futex_wake(m_futex);
+        }
+
+        auto old_value = m_waiter.exchange(this, std::memory_order_acq_rel);
+        if (old_value != nullptr)
+        {
+            auto waiter = static_cast<future_waiter*>(old_value);
+            waiter->m_ctx.submit_next(waiter->m_await_coro, waiter->m_prio);
+        }
+    }
+
+    /**
+     * @brief 阻塞当前线程直到结果就绪
+     */
+    auto wait() noexcept -> void
+    {
+        auto cur = m_futex.load(std::memory_order_acquire);
+        while (cur != kReady)
+        {
+            if (cur == kPending &&
+                !m_futex.compare_exchange_weak(cur, kSleeping, std::memory_order_acq_rel, std::memory_order_acquire))
+            {
+                continue;
+            }
+            futex_wait(m_futex, kSleeping);
+            cur = m_futex.load(std::memory_order_acquire);
+        }
+    }
+
+    /**
+     * @brief 登记等待的协程, 结果已就绪时返回false
+     */
+    auto register_waiter(future_waiter* waiter) noexcept -> bool
+    {
+        awaiter_ptr old_value = nullptr;
+        return m_waiter.compare_exchange_strong(
+            old_value, static_cast<awaiter_ptr>(waiter), std::memory_order_acq_rel, std::memory_order_acquire);
+    }
+
+private:
+    static constexpr uint32_t kPending  = 0;
+    static constexpr uint32_t kSleeping = 1; // 结果未就绪且有线程阻塞在futex上
+    static constexpr uint32_t kReady    = 2;
+
+    std::atomic<uint32_t>    m_futex{kPending};
+    std::atomic<awaiter_ptr> m_waiter{nullptr};
+};
+}; // namespace detail
+
+/**
+ * @brief 由scheduler::spawn返回的任务结果, 既可以在协程中co_await, 也可以在非工作线程上阻塞等待
+ *
+ * 阻塞等待基于futex, 不会忙等. future只能移动, 结果只能取出一次.
+ */
+template<typename return_type>
+class future
+{
+    using state_type = detail::future_state<return_type>;
+
+public:
+    struct [[CORO_AWAIT_HINT]] awaiter : public detail::future_waiter
+    {
+        awaiter(context& ctx, state_type& st) noexcept : future_waiter(ctx), m_st(st) {}
+
+        auto await_ready() noexcept -> bool { return m_st.is_ready(); }
+
+        auto await_suspend(std::coroutine_handle<> handle) noexcept -> bool
+        {
+            m_await_coro = handle;
+            m_prio       = linfo.prio;
+            m_ctx.register_wait();
+            if (m_st.register_waiter(this))
+            {
+                return true;
+            }
+            // 结果在此期间已就绪
+            m_ctx.unregister_wait();
+            m_await_coro = nullptr;
+            return false;
+        }
+
+        auto await_resume() -> decltype(auto)
+        {
+            if (m_await_coro != nullptr)
+            {
+                m_ctx.unregister_wait();
+            }
+            return std::move(m_st).result();
+        }
+
+        state_type& m_st;
+    };
+
+    future() noexcept = default;
+    explicit future(std::shared_ptr<state_type> st) noexcept : m_st(std::move(st)) {}
+    ~future() noexcept = default;
+
+    future(const future&)                    = delete;
+    future(future&&) noexcept                = default;
+    auto operator=(const future&) -> future& = delete;
+    auto operator=(future&&) noexcept -> future& = default;
+
+    inline auto valid() const noexcept -> bool { return m_st != nullptr; }
+
+    inline auto ready() const noexcept -> bool { return m_st->is_ready(); }
+
+    /**
+     * @brief 阻塞当前线程直到结果就绪
+     *
+     * @note 在工作线程上阻塞可能导致产生结果的任务永远得不到执行, 工作线程应使用co_await
+     */
+    auto wait() const noexcept -> void
+    {
+        assert((ready() || !detail::is_in_working_state()) && "future::wait would block a worker thread");
+        m_st->wait();
+    }
+
+    /**
+     * @brief 阻塞直到结果就绪并取出结果, 任务抛出的异常在此重新抛出
+     */
+    auto get() -> decltype(auto)
+    {
+        wait();
+        return std::move(*m_st).result();
+    }
+
+    auto operator co_await() noexcept -> awaiter { return awaiter(local_context(), *m_st); }
+
+private:
+    std::shared_ptr<state_type> m_st{nullptr};
+};
+
+namespace detail
+{
+/**
+ * @brief 执行task并把结果或异常写入共享状态
+ *
+ * @param on_done 结果写入后、唤醒等待者之前调用, 等待者被唤醒后可能立即销毁提交任务的scheduler
+ */
+template<typename return_type, typename done_type>
+auto make_future_task(task<return_type> t, std::shared_ptr<future_state<return_type>> st, done_type on_done)
+    -> task<void>
+{
+    try
+    {
+        if constexpr (std::is_void_v<return_type>)
+        {
+            co_await std::move(t);
+            st->return_void();
+        }
+        else
+        {
+            st->return_value(co_await std::move(t));
+        }
+    }
+    catch (...)
+    {
+        st->set_exception();
+    }
+    on_done();
+    st->set_ready();
+}
+}; // namespace detail
+
+}; // namespace coro
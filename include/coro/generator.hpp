@@ -0,0 +1,185 @@
+/**
+* @file generator.hpp
+* @author daguai
+* @version 1.0
+*/
+#pragma once
+
+#include <coroutine>
+#include <exception>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace coro
+{
+template<typename yield_type>
+class generator;
+
+namespace detail
+{
+template<typename yield_type>
+class generator_promise
+{
+public:
+    using storage_type   = std::remove_reference_t<yield_type>;
+    using reference_type = std::conditional_t<std::is_reference_v<yield_type>, yield_type, yield_type&>;
+
+    generator_promise() noexcept = default;
+    ~generator_promise()         = default;
+
+    auto get_return_object() noexcept -> generator<yield_type>;
+
+    constexpr auto initial_suspend() const noexcept { return std::suspend_always{}; }
+
+    constexpr auto final_suspend() const noexcept { return std::suspend_always{}; }
+
+    /**
+     * @brief 只记录被yield对象的地址, 对象在生成器恢复前一直有效, 因此不需要复制
+     */
+    auto yield_value(storage_type& value) noexcept -> std::suspend_always
+    {
+        m_value = std::addressof(value);
+        return {};
+    }
+
+    auto yield_value(storage_type&& value) noexcept -> std::suspend_always
+    {
+        m_value = std::addressof(value);
+        return {};
+    }
+
+    constexpr auto return_void() noexcept -> void {}
+
+    auto unhandled_exception() noexcept -> void { m_exception_ptr = std::current_exception(); }
+
+    /**
+     * @brief 同步生成器中不允许co_await, 需要等待IO时使用async_generator
+     */
+    template<typename awaitable_type>
+    auto await_transform(awaitable_type&& value) -> std::suspend_never = delete;
+
+    inline auto value() const noexcept -> reference_type { return static_cast<reference_type>(*m_value); }
+
+    auto rethrow_if_exception() -> void
+    {
+        if (m_exception_ptr)
+        {
+            std::rethrow_exception(std::exchange(m_exception_ptr, nullptr));
+        }
+    }
+
+private:
+    storage_type*      m_value{nullptr};
+    std::exception_ptr m_exception_ptr{nullptr};
+};
+}; // namespace detail
+
+/**
+ * @brief 同步生成器, 通过co_yield逐个产生元素, 用法: for (auto& v : gen()) {...}
+ *
+ * promise中只保存元素的指针, 每个元素都不会产生复制与内存分配.
+ * 协程帧与task一样通过operator new分配.
+ */
+template<typename yield_type>
+class generator
+{
+public:
+    using promise_type     = detail::generator_promise<yield_type>;
+    using coroutine_handle = std::coroutine_handle<promise_type>;
+
+    class iterator
+    {
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using difference_type   = std::ptrdiff_t;
+        using value_type        = std::remove_cvref_t<typename promise_type::storage_type>;
+        using reference         = typename promise_type::reference_type;
+        using pointer           = std::add_pointer_t<reference>;
+
+        iterator() noexcept = default;
+        explicit iterator(coroutine_handle coroutine) noexcept : m_coroutine(coroutine) {}
+
+        auto operator==(std::default_sentinel_t) const noexcept -> bool
+        {
+            return m_coroutine == nullptr || m_coroutine.done();
+        }
+
+        auto operator++() -> iterator&
+        {
+            m_coroutine.resume();
+            if (m_coroutine.done())
+            {
+                m_coroutine.promise().rethrow_if_exception();
+            }
+            return *this;
+        }
+
+        auto operator++(int) -> void { ++(*this); }
+
+        auto operator*() const noexcept -> reference { return m_coroutine.promise().value(); }
+
+        auto operator->() const noexcept -> pointer { return std::addressof(operator*()); }
+
+    private:
+        coroutine_handle m_coroutine{nullptr};
+    };
+
+    generator() noexcept = default;
+    explicit generator(coroutine_handle coroutine) noexcept : m_coroutine(coroutine) {}
+
+    generator(const generator&) = delete;
+    generator(generator&& other) noexcept : m_coroutine(std::exchange(other.m_coroutine, nullptr)) {}
+
+    auto operator=(const generator&) -> generator& = delete;
+
+    auto operator=(generator&& other) noexcept -> generator&
+    {
+        if (std::addressof(other) != this)
+        {
+            if (m_coroutine != nullptr)
+            {
+                m_coroutine.destroy();
+            }
+            m_coroutine = std::exchange(other.m_coroutine, nullptr);
+        }
+        return *this;
+    }
+
+    ~generator()
+    {
+        if (m_coroutine != nullptr)
+        {
+            m_coroutine.destroy();
+        }
+    }
+
+    /**
+     * @brief 启动生成器直到产生第一个元素, 只能调用一次
+     */
+    auto begin() -> iterator
+    {
+        if (m_coroutine != nullptr)
+        {
+            ++iterator(m_coroutine);
+        }
+        return iterator(m_coroutine);
+    }
+
+    constexpr auto end() const noexcept -> std::default_sentinel_t { return {}; }
+
+private:
+    coroutine_handle m_coroutine{nullptr};
+};
+
+namespace detail
+{
+template<typename yield_type>
+inline auto generator_promise<yield_type>::get_return_object() noexcept -> generator<yield_type>
+{
+    return generator<yield_type>{std::coroutine_handle<generator_promise>::from_promise(*this)};
+}
+}; // namespace detail
+
+}; // namespace coro
@@ -34,7 +34,11 @@ public:
 
     constexpr auto await_ready() noexcept -> bool { return false; }
 
-    auto await_suspend(std::coroutine_handle<> handle) noexcept -> void { m_info.handle = handle; }
+    auto await_suspend(std::coroutine_handle<> handle) noexcept -> void
+    {
+        m_info.handle = handle;
+        m_info.prio   = coro::detail::linfo.prio;
+    }
     
     auto await_resume() noexcept -> int32_t { return m_info.result; }
 
@@ -1,3 +1,5 @@
+#pragma once
+
 #include "coro/engine.hpp"
 #include "coro/meta_info.hpp"
 #include "coro/uring_proxy.hpp"
@@ -0,0 +1,60 @@
+/**
+* @file buffer_ring.hpp
+* @author daguai
+* @version 1.0
+*/
+#pragma once
+
+#include <cstdint>
+#include <memory>
+
+#include "coro/attribute.hpp"
+#include "coro/uring_proxy.hpp"
+
+namespace coro::io::detail
+{
+/**
+ * @brief io_uring provided buffer ring, 内核在数据到达时自行从环中选取缓冲区
+ *
+ * @note 必须在所属engine的工作线程中构造、使用和析构
+ */
+class buffer_ring
+{
+public:
+    /**
+     * @param buf_count buffer数量, 必须为2的幂
+     * @param buf_size  单个buffer大小
+     */
+    buffer_ring(unsigned int buf_count, unsigned int buf_size) noexcept;
+
+    ~buffer_ring() noexcept;
+
+    CORO_NO_COPY_MOVE(buffer_ring);
+
+    inline auto group_id() const noexcept -> int { return m_bgid; }
+
+    inline auto buf_size() const noexcept -> unsigned int { return m_buf_size; }
+
+    inline auto buf_count() const noexcept -> unsigned int { return m_buf_count; }
+
+    /**
+     * @brief 根据CQE中的buffer id获取buffer地址
+     */
+    inline auto get(uint16_t bid) noexcept -> char* { return m_bufs.get() + size_t(bid) * m_buf_size; }
+
+    /**
+     * @brief 将buffer归还给内核
+     */
+    auto recycle(uint16_t bid) noexcept -> void;
+
+private:
+    uring::uring_proxy&     m_upxy;
+    io_uring_buf_ring*      m_br{nullptr};
+    std::unique_ptr<char[]> m_bufs;
+    unsigned int            m_buf_count;
+    unsigned int            m_buf_size;
+    int                     m_mask;
+    int                     m_bgid;
+};
+
+}; // namespace coro::io::detail
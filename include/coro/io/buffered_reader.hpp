@@ -0,0 +1,309 @@
+/**
+* @file buffered_reader.hpp
+* @author daguai
+* @version 1.0
+*/
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cerrno>
+#include <coroutine>
+#include <cstring>
+#include <memory>
+#include <optional>
+#include <string_view>
+#include <utility>
+
+#include "config.h"
+#include "coro/attribute.hpp"
+#include "coro/task.hpp"
+#include "coro/utils.hpp"
+
+namespace coro::io
+{
+/**
+ * @brief 带缓冲的流式读取器, 在connector之上提供按长度与按分隔符的读取
+ *
+ * connector只需要提供 read(char* buf, size_t len) 并返回结果为int的awaiter, 例如tcp_connector与uds_connector.
+ * 所有的读取都通过同一个read awaiter填充内部缓冲区, 返回的string_view指向内部缓冲区, 在下一次读取前有效.
+ * 失败(EOF, 读取错误, 缓冲区装不下一条完整的消息)时返回std::nullopt, 通过 eof() 与 error() 区分原因.
+ */
+template<typename connector_type>
+class buffered_reader
+{
+    using read_awaiter_type = decltype(std::declval<connector_type&>().read(std::declval<char*>(), size_t{}));
+
+    /**
+     * @brief 包装connector的read awaiter, 恢复时更新缓冲区状态
+     */
+    struct [[CORO_AWAIT_HINT]] fill_awaiter
+    {
+        explicit fill_awaiter(buffered_reader& rd) noexcept
+            : m_rd(rd),
+              m_inner(rd.m_conn.read(rd.m_buf.get() + rd.m_end, rd.m_cap - rd.m_end))
+        {
+        }
+
+        auto await_ready() noexcept -> bool { return m_inner.await_ready(); }
+
+        auto await_suspend(std::coroutine_handle<> handle) noexcept -> decltype(auto)
+        {
+            return m_inner.await_suspend(handle);
+        }
+
+        /**
+         * @return 是否读到了新的数据
+         */
+        auto await_resume() noexcept -> bool { return m_rd.on_filled(m_inner.await_resume()); }
+
+        buffered_reader&  m_rd;
+        read_awaiter_type m_inner;
+    };
+
+public:
+    explicit buffered_reader(connector_type& conn, size_t capacity = ::coro::config::kReaderBufSize) noexcept
+        : m_conn(conn),
+          m_buf(std::make_unique<char[]>(capacity)),
+          m_cap(capacity)
+    {
+        assert(capacity > 0);
+    }
+
+    CORO_NO_COPY_MOVE(buffered_reader);
+
+    /**
+     * @brief 缓冲区中尚未消费的字节数
+     */
+    inline auto buffered() const noexcept -> size_t { return m_end - m_begin; }
+
+    inline auto capacity() const noexcept -> size_t { return m_cap; }
+
+    /**
+     * @brief 对端是否已经关闭
+     */
+    inline auto eof() const noexcept -> bool { return m_eof; }
+
+    /**
+     * @brief 最近一次读取操作的错误码(-errno), 0表示没有错误
+     *
+     * @note 每次读取操作开始时清零; 缓冲区装不下完整的分隔符消息时为-ENOBUFS
+     */
+    inline auto error() const noexcept -> int { return m_error; }
+
+    /**
+     * @brief 等待缓冲区中至少有n个字节, 返回前n个字节但不消费, EOF或出错时返回的数据可能不足n个字节
+     *
+     * @param n 不能超过capacity()
+     */
+    auto peek(size_t n) -> task<std::string_view>
+    {
+        assert(n <= m_cap);
+        m_error = 0;
+        while (buffered() < n)
+        {
+            bool filled = co_await fill();
+            if (!filled)
+            {
+                break;
+            }
+        }
+        co_return std::string_view(m_buf.get() + m_begin, std::min(n, buffered()));
+    }
+
+    /**
+     * @brief 读取并消费恰好n个字节
+     *
+     * @param n 不能超过capacity()
+     */
+    auto read_exact(size_t n) -> task<std::optional<std::string_view>>
+    {
+        assert(n <= m_cap);
+        m_error = 0;
+        while (buffered() < n)
+        {
+            bool filled = co_await fill();
+            if (!filled)
+            {
+                co_return std::nullopt;
+            }
+        }
+        co_return consume(n);
+    }
+
+    /**
+     * @brief 读取恰好n个字节到dst, 缓冲区之外的大块数据直接读入dst, 不经过内部缓冲区
+     *
+     * @return 读取的字节数, 小于n表示提前EOF, 负数为错误码
+     */
+    auto read_exact(char* dst, size_t n) -> task<int>
+    {
+        m_error     = 0;
+        size_t done = std::min(n, buffered());
+        memcpy(dst, m_buf.get() + m_begin, done);
+        m_begin += done;
+
+        while (done < n)
+        {
+            if (n - done >= m_cap)
+            {
+                m_begin = m_end = 0;
+                int res = co_await m_conn.read(dst + done, n - done);
+                if (res <= 0)
+                {
+                    record_failure(res);
+                    break;
+                }
+                done += res;
+                continue;
+            }
+
+            bool filled = co_await fill();
+            if (!filled)
+            {
+                break;
+            }
+            auto cnt = std::min(n - done, buffered());
+            memcpy(dst + done, m_buf.get() + m_begin, cnt);
+            m_begin += cnt;
+            done += cnt;
+        }
+        co_return (done < n && m_error != 0) ? m_error : static_cast<int>(done);
+    }
+
+    /**
+     * @brief 读取直到delim, 返回的数据包含delim
+     *
+     * @param delim 不能为空, 长度不能超过capacity()
+     */
+    auto read_until(std::string_view delim) -> task<std::optional<std::string_view>>
+    {
+        return read_until_impl(delim, false);
+    }
+
+    /**
+     * @brief 读取一行, 返回的数据不包含行尾的"\n"或"\r\n"
+     */
+    auto read_line() -> task<std::optional<std::string_view>> { return read_until_impl("\n", true); }
+
+private:
+    auto read_until_impl(std::string_view delim, bool strip_line) -> task<std::optional<std::string_view>>
+    {
+        assert(!delim.empty() && delim.size() <= m_cap);
+        m_error = 0;
+
+        // 已经确认不包含delim的前缀长度, 重新填充后从这里继续扫描
+        size_t scanned = 0;
+        size_t pos;
+        while ((pos = find_delim(delim, scanned)) == npos)
+        {
+            scanned = buffered() >= delim.size() ? buffered() - delim.size() + 1 : 0;
+            if (buffered() == m_cap)
+            {
+                m_error = -ENOBUFS;
+                co_return std::nullopt;
+            }
+            bool filled = co_await fill();
+            if (!filled)
+            {
+                co_return std::nullopt;
+            }
+        }
+
+        auto view = consume(pos + delim.size());
+        if (strip_line)
+        {
+            view.remove_suffix(delim.size());
+            if (!view.empty() && view.back() == '\r')
+            {
+                view.remove_suffix(1);
+            }
+        }
+        co_return view;
+    }
+
+    /**
+     * @brief 在未消费的数据中从from开始查找delim, 先用SIMD扫描首字节再比较剩余部分
+     */
+    auto find_delim(std::string_view delim, size_t from) const noexcept -> size_t
+    {
+        auto data = m_buf.get() + m_begin;
+        auto len  = buffered();
+        while (from + delim.size() <= len)
+        {
+            auto range = len - delim.size() + 1 - from;
+            auto off   = utils::find_byte(data + from, range, delim[0]);
+            if (off == range)
+            {
+                return npos;
+            }
+
+            auto pos = from + off;
+            if (memcmp(data + pos + 1, delim.data() + 1, delim.size() - 1) == 0)
+            {
+                return pos;
+            }
+            from = pos + 1;
+        }
+        return npos;
+    }
+
+    auto consume(size_t n) noexcept -> std::string_view
+    {
+        std::string_view view(m_buf.get() + m_begin, n);
+        m_begin += n;
+        return view;
+    }
+
+    auto fill() noexcept -> fill_awaiter
+    {
+        // 把未消费的数据移动到缓冲区头部, 为本次读取腾出尽可能多的空间
+        if (m_begin == m_end)
+        {
+            m_begin = m_end = 0;
+        }
+        else if (m_begin > 0)
+        {
+            memmove(m_buf.get(), m_buf.get() + m_begin, buffered());
+            m_end -= m_begin;
+            m_begin = 0;
+        }
+        return fill_awaiter(*this);
+    }
+
+    auto on_filled(int res) noexcept -> bool
+    {
+        if (res > 0)
+        {
+            m_end += res;
+            return true;
+        }
+        record_failure(res);
+        return false;
+    }
+
+    inline auto record_failure(int res) noexcept -> void
+    {
+        if (res == 0)
+        {
+            m_eof = true;
+        }
+        else
+        {
+            m_error = res;
+        }
+    }
+
+private:
+    static constexpr size_t npos = std::string_view::npos;
+
+    connector_type&         m_conn;
+    std::unique_ptr<char[]> m_buf;
+    size_t                  m_cap;
+    size_t                  m_begin{0}; // 未消费数据的起始位置
+    size_t                  m_end{0};   // 未消费数据的结束位置
+    int                     m_error{0};
+    bool                    m_eof{false};
+};
+
+}; // namespace coro::io
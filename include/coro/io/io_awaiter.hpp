@@ -7,8 +7,13 @@
 #pragma once
 
 #include <netdb.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <sys/un.h>
 
+#include "config.h"
 #include "coro/io/base_awaiter.hpp"
+#include "coro/io/net/socket_address.hpp"
 
 namespace coro::io
 {
@@ -80,6 +85,143 @@ public:
     static auto callback(io_info* data, int res) noexcept -> void;
 };
 }; // namespace tcp
+
+/**
+ * @brief udp awaiter
+ *
+ */
+namespace udp
+{
+class udp_sendmsg_awaiter : public detail::base_io_awaiter
+{
+public:
+    /**
+     * @param gso_size 大于0时通过UDP_SEGMENT让内核按该大小把buf切分为多个datagram(GSO)
+     */
+    udp_sendmsg_awaiter(
+        int             sockfd,
+        const char*     buf,
+        size_t          len,
+        const sockaddr* addr,
+        socklen_t       addrlen,
+        uint16_t        gso_size = 0,
+        int             io_flag  = 0,
+        int             sqe_flag = 0) noexcept;
+
+    static auto callback(io_info* data, int res) noexcept -> void;
+
+private:
+    iovec  m_iov;
+    msghdr m_msg;
+    alignas(cmsghdr) char m_control[CMSG_SPACE(sizeof(uint16_t))];
+};
+
+class udp_recvmsg_awaiter : public detail::base_io_awaiter
+{
+public:
+    /**
+     * @param src 非空时写入datagram的源地址
+     * @param gro_size 非空时写入GRO合并的分段大小, 未合并时写入0
+     */
+    udp_recvmsg_awaiter(
+        int             sockfd,
+        char*           buf,
+        size_t          len,
+        socket_address* src,
+        int*            gro_size,
+        int             io_flag  = 0,
+        int             sqe_flag = 0) noexcept;
+
+    static auto callback(io_info* data, int res) noexcept -> void;
+
+private:
+    iovec           m_iov;
+    msghdr          m_msg;
+    socket_address* m_src;
+    int*            m_gro_size;
+    alignas(cmsghdr) char m_control[CMSG_SPACE(sizeof(int))];
+};
+
+class udp_close_awaiter : public detail::base_io_awaiter
+{
+public:
+    udp_close_awaiter(int sockfd) noexcept;
+
+    static auto callback(io_info* data, int res) noexcept -> void;
+};
+}; // namespace udp
+
+/**
+ * @brief unix domain socket awaiter
+ *
+ */
+namespace uds
+{
+// 流式读写与tcp的awaiter完全一致
+using uds_accept_awaiter  = tcp::tcp_accept_awaiter;
+using uds_read_awaiter    = tcp::tcp_read_awaiter;
+using uds_write_awaiter   = tcp::tcp_write_awaiter;
+using uds_close_awaiter   = tcp::tcp_close_awaiter;
+using uds_connect_awaiter = tcp::tcp_connect_awaiter;
+
+class uds_sendmsg_awaiter : public detail::base_io_awaiter
+{
+public:
+    /**
+     * @param dst 目的地址, 仅用于未连接的datagram socket, 可以为nullptr
+     * @param fds 通过SCM_RIGHTS传递的描述符, 数量超过config::kUdsMaxFds时不发送, 直接以-EINVAL完成
+     */
+    uds_sendmsg_awaiter(
+        int                   sockfd,
+        const char*           buf,
+        size_t                len,
+        const socket_address* dst,
+        const int*            fds,
+        size_t                nfds,
+        int                   io_flag  = 0,
+        int                   sqe_flag = 0) noexcept;
+
+    static auto callback(io_info* data, int res) noexcept -> void;
+
+    static auto reject_callback(io_info* data, int res) noexcept -> void;
+
+private:
+    iovec  m_iov;
+    msghdr m_msg;
+    alignas(cmsghdr) char m_control[CMSG_SPACE(sizeof(int) * ::coro::config::kUdsMaxFds)];
+};
+
+class uds_recvmsg_awaiter : public detail::base_io_awaiter
+{
+public:
+    /**
+     * @param src 非空时写入datagram的源地址
+     * @param fds 非空时写入收到的描述符, 超出max_fds的描述符会被关闭
+     * @param nfds 非空时写入收到的描述符数量
+     */
+    uds_recvmsg_awaiter(
+        int             sockfd,
+        char*           buf,
+        size_t          len,
+        socket_address* src,
+        int*            fds,
+        size_t          max_fds,
+        size_t*         nfds,
+        int             io_flag  = 0,
+        int             sqe_flag = 0) noexcept;
+
+    static auto callback(io_info* data, int res) noexcept -> void;
+
+private:
+    iovec           m_iov;
+    msghdr          m_msg;
+    socket_address* m_src;
+    int*            m_fds;
+    size_t          m_max_fds;
+    size_t*         m_nfds;
+    alignas(cmsghdr) char m_control[CMSG_SPACE(sizeof(int) * ::coro::config::kUdsMaxFds)];
+};
+}; // namespace uds
 }; // namespace net
 
 }; // namespace coro::io
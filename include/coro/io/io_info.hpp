@@ -4,6 +4,8 @@
 #include <cstdint>
 #include <functional>
 
+#include "coro/detail/types.hpp"
+
 namespace coro::io::detail 
 {
 #define CASTPTR(data)  reinterpret_cast<uintptr_t>(data)
@@ -22,6 +24,13 @@ enum io_type
     tcp_close,
     tcp_read,
     tcp_write,
+    udp_sendmsg,
+    udp_recvmsg,
+    udp_recv_multishot,
+    udp_close,
+    uds_sendmsg,
+    uds_recvmsg,
+    async_cancel,
     stdin,
     timer,
     none
@@ -31,9 +40,12 @@ struct io_info
 {
     coroutine_handle<> handle;
     int32_t            result;
+    uint32_t           flags; // cqe flags, 用于 multishot 与 buffer select
     io_type            type;
     uintptr_t          data;
     cb_type            cb;
+    // 等待者所在任务队列的优先级, IO完成后按该优先级重新入队
+    ::coro::detail::task_priority prio{::coro::detail::task_priority::normal};
 };
 
 inline uintptr_t ioinfo_to_ptr(io_info* info) noexcept
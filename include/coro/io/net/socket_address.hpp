@@ -0,0 +1,104 @@
+/**
+* @file socket_address.hpp
+* @author daguai
+* @version 1.0
+*/
+#pragma once
+
+#include <arpa/inet.h>
+#include <cstring>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+namespace coro::io::net
+{
+/**
+ * @brief 通用的socket地址, 支持ipv4, ipv6与unix domain socket
+ *
+ * 地址内联存储在sockaddr_storage中, connect/sendmsg直接使用data()与size(), 不需要额外的拷贝与分配
+ */
+class socket_address
+{
+public:
+    socket_address() noexcept
+    {
+        memset(&m_addr, 0, sizeof(m_addr));
+        m_addr.ss_family = AF_UNSPEC;
+    }
+
+    /**
+     * @brief 解析ipv4地址, 解析失败时返回的地址 valid() 为false
+     */
+    static auto ipv4(const char* addr, int port) noexcept -> socket_address;
+
+    /**
+     * @brief 解析ipv6地址, 解析失败时返回的地址 valid() 为false
+     */
+    static auto ipv6(const char* addr, int port) noexcept -> socket_address;
+
+    /**
+     * @brief 根据addr的格式自动选择ipv4或ipv6, addr为nullptr时返回双栈的通配地址
+     */
+    static auto parse(const char* addr, int port) noexcept -> socket_address;
+
+    /**
+     * @brief ipv6通配地址"::", 配合IPV6_V6ONLY=0可以同时接收ipv4与ipv6连接
+     */
+    static auto any(int port) noexcept -> socket_address;
+
+    /**
+     * @brief ipv4通配地址"0.0.0.0"
+     */
+    static auto any_ipv4(int port) noexcept -> socket_address;
+
+    /**
+     * @brief unix domain socket地址, path以'@'开头时使用abstract namespace
+     */
+    static auto unix_path(const char* path) noexcept -> socket_address;
+
+    inline auto valid() const noexcept -> bool { return m_addr.ss_family != AF_UNSPEC; }
+
+    inline auto family() const noexcept -> int { return m_addr.ss_family; }
+
+    inline auto is_ipv4() const noexcept -> bool { return m_addr.ss_family == AF_INET; }
+
+    inline auto is_ipv6() const noexcept -> bool { return m_addr.ss_family == AF_INET6; }
+
+    inline auto is_unix() const noexcept -> bool { return m_addr.ss_family == AF_UNIX; }
+
+    inline auto data() const noexcept -> const sockaddr* { return reinterpret_cast<const sockaddr*>(&m_addr); }
+
+    inline auto data() noexcept -> sockaddr* { return reinterpret_cast<sockaddr*>(&m_addr); }
+
+    /**
+     * @brief 地址的有效长度
+     */
+    inline auto size() const noexcept -> socklen_t { return m_len; }
+
+    /**
+     * @brief 可写入的最大长度, 用于recvmsg/accept等由内核填充地址的场景
+     */
+    static constexpr auto capacity() noexcept -> socklen_t { return sizeof(sockaddr_storage); }
+
+    /**
+     * @brief 由内核填充地址后设置有效长度
+     */
+    inline auto set_size(socklen_t len) noexcept -> void { m_len = len; }
+
+    /**
+     * @brief 端口号(主机字节序), unix domain socket返回0
+     */
+    auto port() const noexcept -> int;
+
+    /**
+     * @brief ipv4/ipv6 地址是否为通配地址
+     */
+    auto is_any() const noexcept -> bool;
+
+private:
+    sockaddr_storage m_addr;
+    socklen_t        m_len{0};
+};
+
+}; // namespace coro::io::net
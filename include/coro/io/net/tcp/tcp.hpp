@@ -2,16 +2,23 @@
 
 #include <arpa/inet.h>
 #include <cassert>
+#include <cerrno>
 #include <cstdlib>
 #include <cstring>
 #include <netdb.h>
+#include <stop_token>
+#include <string>
 #include <sys/socket.h>
 #include <sys/types.h>
 #include <unistd.h>
 
 #include "config.h"
+#include "coro/context.hpp"
 #include "coro/io/base_io_type.hpp"
 #include "coro/io/io_awaiter.hpp"
+#include "coro/io/net/socket_address.hpp"
+#include "coro/scheduler.hpp"
+#include "coro/task.hpp"
 
 namespace coro::io::net::tcp
 {
@@ -54,14 +61,38 @@ class tcp_server
 public:
     explicit tcp_server(int port = ::coro::config::kDefaultPort) noexcept : tcp_server(nullptr, port) {}
 
-    tcp_server(const char* addr, int port) noexcept;
+    /**
+     * @brief 创建监听在addr:port上的tcp socket, addr可以是ipv4或ipv6, 为nullptr时监听双栈通配地址
+     *
+     * @param backlog listen的backlog队列大小
+     * @param reuse_port 是否开启SO_REUSEPORT, 开启后多个socket可以监听同一端口, 由内核在它们之间分发连接
+     */
+    tcp_server(
+        const char* addr, int port, int backlog = ::coro::config::kBacklog, bool reuse_port = false) noexcept;
+
+    /**
+     * @brief 创建监听在addr上的tcp socket, ipv6通配地址会关闭IPV6_V6ONLY以同时接收ipv4连接
+     */
+    explicit tcp_server(
+        const socket_address& addr, int backlog = ::coro::config::kBacklog, bool reuse_port = false) noexcept;
 
     tcp_accept_awaiter accept(int io_flags = 0) noexcept;
 
+    tcp_close_awaiter close() noexcept
+    {
+        m_fixed_fd.return_back();
+        return tcp_close_awaiter(m_original_fd);
+    }
+
+    /**
+     * @brief 获取原始的监听描述符(未转换为fixed fd)
+     */
+    inline auto fd() const noexcept -> int { return m_original_fd; }
+
 private:
-    int         m_listenfd;
-    int         m_port;
-    sockaddr_in m_serveraddr;
+    int            m_listenfd; // 可能会转换为fix fd
+    int            m_original_fd;
+    socket_address m_serveraddr;
 
     detail::fixed_fds m_fixed_fd;
     int               m_sqe_flag{0};
@@ -70,14 +101,72 @@ private:
 class tcp_client
 {
 public:
+    /**
+     * @brief addr可以是ipv4或ipv6地址, 为nullptr时连接ipv4通配地址
+     */
     tcp_client(const char* addr, int port) noexcept;
 
+    explicit tcp_client(const socket_address& addr) noexcept;
+
     tcp_connect_awaiter connect() noexcept;
 
 private:
-    int         m_clientfd;
-    int         m_port;
-    sockaddr_in m_serveraddr;
+    int            m_clientfd;
+    socket_address m_serveraddr;
 };
 
+/**
+ * @brief serve_sharded中每个context上运行的accept循环, token请求停止后关闭监听socket并返回
+ */
+template<typename handler_type>
+auto sharded_accept_loop(std::string addr, int port, int backlog, handler_type handler, std::stop_token token)
+    -> task<>
+{
+    // listener在所属context的线程上创建, fixed fd也从该context的uring中借用
+    auto server = tcp_server(addr.empty() ? nullptr : addr.c_str(), port, backlog, true);
+    {
+        // 停止时shutdown监听socket, 正在进行的accept以错误返回. 回调可能在其他线程执行,
+        // 因此在close之前析构stop_callback, 保证回调不会作用于已经关闭的描述符
+        std::stop_callback cb(token, [fd = server.fd()]() { ::shutdown(fd, SHUT_RDWR); });
+        while (!token.stop_requested())
+        {
+            int fd = co_await server.accept();
+            if (fd < 0)
+            {
+                if (!token.stop_requested() && (fd == -EINTR || fd == -EAGAIN || fd == -ECONNABORTED))
+                {
+                    continue;
+                }
+                // log::error("sharded accept error");
+                break;
+            }
+            // 连接由接收它的context直接处理, 不跨context转交
+            submit_to_context(handler(fd));
+        }
+    }
+    co_await server.close();
+}
+
+/**
+ * @brief 在每个context上各启动一个SO_REUSEPORT监听socket与accept循环, 需要在scheduler::loop之前调用
+ *
+ * @param handler 形如 task<>(int fd) 的可调用对象, 每个新连接在accept它的context中执行一次
+ * @param token 请求停止后各accept循环关闭自己的监听socket并结束, 默认的token永远不会停止
+ * @note 已经accept的连接不受token影响, scheduler在这些连接处理完后才能结束
+ */
+template<typename handler_type>
+auto serve_sharded(
+    const char*     addr,
+    int             port,
+    handler_type    handler,
+    std::stop_token token   = {},
+    int             backlog = ::coro::config::kShardedBacklog) noexcept -> void
+{
+    std::string address = addr == nullptr ? std::string() : std::string(addr);
+    for (size_t i = 0; i < scheduler::context_count(); i++)
+    {
+        scheduler::submit(sharded_accept_loop(address, port, backlog, handler, token), i);
+    }
+}
+
 }; // namespace coro::io::net::tcp
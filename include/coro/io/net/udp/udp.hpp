@@ -0,0 +1,187 @@
+/**
+* @file udp.hpp
+* @author daguai
+* @version 1.0
+*/
+#pragma once
+
+#include <arpa/inet.h>
+#include <cassert>
+#include <coroutine>
+#include <cstdint>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <vector>
+
+#include "config.h"
+#include "coro/attribute.hpp"
+#include "coro/io/buffer_ring.hpp"
+#include "coro/io/io_awaiter.hpp"
+#include "coro/io/net/socket_address.hpp"
+
+namespace coro::io::net::udp
+{
+/**
+ * @brief udp_receiver收到的一个datagram, 数据位于provided buffer中
+ *
+ * @note 使用完毕后需要调用 udp_receiver::recycle 归还buffer
+ */
+struct udp_datagram
+{
+    inline auto ok() const noexcept -> bool { return len >= 0; }
+
+    const char*    data{nullptr};   // 数据起始地址
+    int            len{0};          // 数据长度, 小于0时为错误码(-errno)
+    int            segment_size{0}; // GRO合并后每个分段的大小, 0表示未合并
+    socket_address src;             // 源地址
+    int32_t        bid{-1};         // provided buffer id, 小于0表示不占用buffer
+};
+
+class udp_socket
+{
+public:
+    /**
+     * @brief 创建未绑定地址的udp socket, 通常用于客户端
+     *
+     * @param family AF_INET或AF_INET6, 需要与目的地址一致
+     */
+    explicit udp_socket(int family = AF_INET) noexcept;
+
+    /**
+     * @brief 创建udp socket并绑定到addr:port, addr可以是ipv4或ipv6, 为nullptr时绑定双栈通配地址
+     */
+    udp_socket(const char* addr, int port) noexcept;
+
+    /**
+     * @brief 创建udp socket并绑定到addr, ipv6通配地址会关闭IPV6_V6ONLY
+     */
+    explicit udp_socket(const socket_address& addr) noexcept;
+
+    /**
+     * @brief 开启UDP_GRO, 内核会把同一条流的多个datagram合并后一次交付
+     *
+     * @return true/false
+     */
+    auto enable_gro() noexcept -> bool;
+
+    inline auto fd() const noexcept -> int { return m_sockfd; }
+
+    udp_sendmsg_awaiter send_to(const char* buf, size_t len, const socket_address& dst, int io_flags = 0) noexcept
+    {
+        return udp_sendmsg_awaiter(m_sockfd, buf, len, dst.data(), dst.size(), 0, io_flags);
+    }
+
+    /**
+     * @brief 通过GSO一次sendmsg发送多个datagram, buf按segment_size切分, 最后一段可以更短
+     */
+    udp_sendmsg_awaiter
+    send_segments(
+        const char* buf, size_t len, uint16_t segment_size, const socket_address& dst, int io_flags = 0) noexcept
+    {
+        return udp_sendmsg_awaiter(m_sockfd, buf, len, dst.data(), dst.size(), segment_size, io_flags);
+    }
+
+    udp_recvmsg_awaiter
+    recv_from(char* buf, size_t len, socket_address* src = nullptr, int* gro_size = nullptr, int io_flags = 0) noexcept
+    {
+        return udp_recvmsg_awaiter(m_sockfd, buf, len, src, gro_size, io_flags);
+    }
+
+    udp_close_awaiter close() noexcept { return udp_close_awaiter(m_sockfd); }
+
+private:
+    int m_sockfd;
+};
+
+/**
+ * @brief 基于multishot recvmsg与provided buffer的udp批量接收器
+ *
+ * 一次提交的recvmsg请求会持续产生CQE, 每个CQE携带一个内核选取的buffer, 避免了每个datagram一次SQE提交.
+ * 接收器只能在创建它的context中使用, 销毁前必须 co_await stop()
+ */
+class udp_receiver
+{
+    struct completion
+    {
+        int32_t  res;
+        uint32_t flags;
+    };
+
+public:
+    struct [[CORO_AWAIT_HINT]] recv_awaiter
+    {
+        auto await_ready() noexcept -> bool { return m_rx.m_num_done > 0; }
+
+        auto await_suspend(std::coroutine_handle<> handle) noexcept -> void;
+
+        auto await_resume() noexcept -> udp_datagram { return m_rx.pop_datagram(); }
+
+        udp_receiver& m_rx;
+    };
+
+    struct [[CORO_AWAIT_HINT]] stop_awaiter
+    {
+        auto await_ready() noexcept -> bool { return !m_rx.m_armed; }
+
+        auto await_suspend(std::coroutine_handle<> handle) noexcept -> void;
+
+        constexpr auto await_resume() noexcept -> void {}
+
+        udp_receiver& m_rx;
+    };
+
+    udp_receiver(
+        udp_socket&  sock,
+        unsigned int buf_count = ::coro::config::kUdpBufCount,
+        unsigned int buf_size  = ::coro::config::kUdpBufSize) noexcept;
+
+    ~udp_receiver() noexcept;
+
+    CORO_NO_COPY_MOVE(udp_receiver);
+
+    /**
+     * @brief 等待下一个datagram
+     *
+     * 内核终止multishot请求时(例如provided buffer耗尽), 终止的CQE作为一个不占用buffer的datagram返回,
+     * 其len为错误码(buffer耗尽时为-ENOBUFS), 调用者应跳过它并归还持有的buffer. 终止后请求不会在回调中重新提交,
+     * 而是在之后某次recv需要挂起时重新提交, 尚未读取的datagram仍留在socket中, 不会丢失.
+     */
+    recv_awaiter recv() noexcept { return recv_awaiter{*this}; }
+
+    /**
+     * @brief 归还datagram占用的provided buffer
+     */
+    auto recycle(const udp_datagram& dg) noexcept -> void;
+
+    /**
+     * @brief 取消multishot请求并等待其结束
+     */
+    stop_awaiter stop() noexcept { return stop_awaiter{*this}; }
+
+private:
+    auto arm() noexcept -> void;
+
+    auto pop_datagram() noexcept -> udp_datagram;
+
+    static auto callback(io_info* data, int res) noexcept -> void;
+
+    static auto cancel_callback(io_info* data, int res) noexcept -> void;
+
+    auto finish_stop() noexcept -> void;
+
+private:
+    int                     m_sockfd;
+    detail::buffer_ring     m_ring;
+    msghdr                  m_msg;  // multishot仅使用其中的namelen与controllen来划分buffer布局
+    io_info                 m_info;
+    io_info                 m_cancel_info;
+    std::vector<completion> m_done; // 尚未被消费的CQE环形队列
+    size_t                  m_done_head{0};
+    size_t                  m_num_done{0};
+    std::coroutine_handle<> m_waiter{nullptr};
+    std::coroutine_handle<> m_stop_waiter{nullptr};
+    bool                    m_armed{false};
+    int                     m_stop_pending{0};
+};
+
+}; // namespace coro::io::net::udp
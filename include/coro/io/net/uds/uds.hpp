@@ -0,0 +1,168 @@
+/**
+* @file uds.hpp
+* @author daguai
+* @version 1.0
+*/
+#pragma once
+
+#include <cassert>
+#include <cstdlib>
+#include <cstring>
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "config.h"
+#include "coro/io/base_io_type.hpp"
+#include "coro/io/io_awaiter.hpp"
+#include "coro/io/net/socket_address.hpp"
+
+namespace coro::io::net::uds
+{
+/**
+ * @brief 已建立连接的流式unix domain socket, 读写接口与tcp_connector一致
+ */
+class uds_connector
+{
+public:
+    explicit uds_connector(int sockfd) noexcept : m_sockfd(sockfd), m_original_fd(sockfd), m_sqe_flag(0)
+    {
+        m_fixed_fd.assign(m_sockfd, m_sqe_flag);
+    }
+
+    uds_read_awaiter read(char* buf, size_t len, int io_flags = 0) noexcept
+    {
+        return uds_read_awaiter(m_sockfd, buf, len, io_flags, m_sqe_flag);
+    }
+
+    uds_write_awaiter write(char* buf, size_t len, int io_flags = 0) noexcept
+    {
+        return uds_write_awaiter(m_sockfd, buf, len, io_flags, m_sqe_flag);
+    }
+
+    /**
+     * @brief 发送数据的同时通过SCM_RIGHTS传递描述符, len至少为1
+     * @note nfds超过config::kUdsMaxFds时返回-EINVAL
+     */
+    uds_sendmsg_awaiter send_fds(const char* buf, size_t len, const int* fds, size_t nfds, int io_flags = 0) noexcept
+    {
+        return uds_sendmsg_awaiter(m_sockfd, buf, len, nullptr, fds, nfds, io_flags, m_sqe_flag);
+    }
+
+    /**
+     * @brief 接收数据与对端传递的描述符, 收到的描述符数量写入nfds
+     */
+    uds_recvmsg_awaiter
+    recv_fds(char* buf, size_t len, int* fds, size_t max_fds, size_t* nfds, int io_flags = 0) noexcept
+    {
+        return uds_recvmsg_awaiter(m_sockfd, buf, len, nullptr, fds, max_fds, nfds, io_flags, m_sqe_flag);
+    }
+
+    uds_close_awaiter close() noexcept
+    {
+        m_fixed_fd.return_back();
+        return uds_close_awaiter(m_original_fd);
+    }
+
+private:
+    int       m_sockfd;      // 可能会转换为fix fd
+    const int m_original_fd; // 原始的sockfd
+
+    detail::fixed_fds m_fixed_fd;
+    int               m_sqe_flag;
+};
+
+class uds_server
+{
+public:
+    /**
+     * @brief 创建监听在path上的流式unix domain socket, path以'@'开头时使用abstract namespace
+     *
+     * @note 文件系统中已存在的同名socket文件仅在没有进程监听(connect返回ECONNREFUSED)时被删除,
+     *       其他文件或仍在使用的socket保持不变, 随后的bind会失败
+     */
+    explicit uds_server(const char* path) noexcept : uds_server(socket_address::unix_path(path)) {}
+
+    explicit uds_server(const socket_address& addr) noexcept;
+
+    uds_accept_awaiter accept(int io_flags = 0) noexcept;
+
+private:
+    int            m_listenfd;
+    socket_address m_serveraddr;
+
+    detail::fixed_fds m_fixed_fd;
+    int               m_sqe_flag{0};
+};
+
+class uds_client
+{
+public:
+    explicit uds_client(const char* path) noexcept : uds_client(socket_address::unix_path(path)) {}
+
+    explicit uds_client(const socket_address& addr) noexcept;
+
+    uds_connect_awaiter connect() noexcept;
+
+private:
+    int            m_clientfd;
+    socket_address m_serveraddr;
+};
+
+/**
+ * @brief datagram类型的unix domain socket
+ */
+class uds_datagram
+{
+public:
+    /**
+     * @brief 创建datagram socket, path非空时绑定到path
+     */
+    explicit uds_datagram(const char* path = nullptr) noexcept;
+
+    explicit uds_datagram(const socket_address& addr) noexcept;
+
+    inline auto fd() const noexcept -> int { return m_sockfd; }
+
+    uds_sendmsg_awaiter send_to(const char* buf, size_t len, const socket_address& dst, int io_flags = 0) noexcept
+    {
+        return uds_sendmsg_awaiter(m_sockfd, buf, len, &dst, nullptr, 0, io_flags);
+    }
+
+    /**
+     * @brief 发送datagram的同时通过SCM_RIGHTS传递描述符
+     */
+    uds_sendmsg_awaiter send_fds_to(
+        const char* buf, size_t len, const socket_address& dst, const int* fds, size_t nfds, int io_flags = 0) noexcept
+    {
+        return uds_sendmsg_awaiter(m_sockfd, buf, len, &dst, fds, nfds, io_flags);
+    }
+
+    uds_recvmsg_awaiter recv_from(char* buf, size_t len, socket_address* src = nullptr, int io_flags = 0) noexcept
+    {
+        return uds_recvmsg_awaiter(m_sockfd, buf, len, src, nullptr, 0, nullptr, io_flags);
+    }
+
+    uds_recvmsg_awaiter recv_fds_from(
+        char*           buf,
+        size_t          len,
+        int*            fds,
+        size_t          max_fds,
+        size_t*         nfds,
+        socket_address* src      = nullptr,
+        int             io_flags = 0) noexcept
+    {
+        return uds_recvmsg_awaiter(m_sockfd, buf, len, src, fds, max_fds, nfds, io_flags);
+    }
+
+    uds_close_awaiter close() noexcept { return uds_close_awaiter(m_sockfd); }
+
+private:
+    auto bind_local(const socket_address& addr) noexcept -> void;
+
+private:
+    int m_sockfd;
+};
+
+}; // namespace coro::io::net::uds
@@ -1,8 +1,10 @@
 #pragma once
 
 #include <atomic>
+#include <coroutine>
 
 #include "coro/attribute.hpp"
+#include "coro/detail/types.hpp"
 
 namespace coro 
 {
@@ -21,6 +23,10 @@ struct CORO_ALIGN local_info
     context* ctx{nullptr}; 
     // 存储执行引擎engine
     engine*  egn{nullptr};
+    // 最近一个运行结束的顶层协程, 由engine在resume返回后清理
+    std::coroutine_handle<> finished{nullptr};
+    // 正在执行的任务所在队列的优先级, IO与同步原语的等待者被唤醒后按该优先级重新入队
+    task_priority prio{task_priority::normal};
 };
 
 
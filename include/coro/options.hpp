@@ -0,0 +1,66 @@
+/**
+* @file options.hpp
+* @author daguai
+* @version 1.0
+*/
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "config.h"
+#include "coro/detail/types.hpp"
+
+namespace coro
+{
+/**
+ * @brief engine的运行时参数, 默认值来自config.h
+ */
+struct engine_options
+{
+    // SQE和CQE的队列大小
+    unsigned int entry_length{config::kEntryLength};
+    // normal优先级任务队列的容量, 向上取整为2的幂
+    size_t queue_cap{config::kQueCap};
+    // high与low优先级任务队列的容量, 向上取整为2的幂
+    size_t prio_queue_cap{config::kPrioQueCap};
+#ifdef ENABLE_SQPOOL
+    bool sqpoll{true};
+#else
+    // 是否启用IORING_SETUP_SQPOLL, 由内核线程轮询SQ
+    bool sqpoll{false};
+#endif // ENABLE_SQPOOL
+    // SQPOLL内核线程空闲多久后休眠(毫秒)
+    unsigned int sq_thread_idle{config::kSqthreadIdle};
+    // 是否在第一次发起IO时才创建io_uring
+    bool lazy_ring{config::kLazyRing};
+    // 是否与同一scheduler中先创建的io_uring共享内核的io-wq线程池.
+    // 开启sqpoll时ATTACH_WQ还会让这些io_uring共用一个SQPOLL内核线程, 所有context的提交都由它轮询,
+    // 因此sqpoll下默认不共享, 需要同时设置attach_wq_sqpoll
+    bool attach_wq{config::kAttachWq};
+    // 开启sqpoll时是否仍然共享io-wq线程池与SQPOLL内核线程, 仅在attach_wq开启时生效
+    bool attach_wq_sqpoll{false};
+    // 唤醒同一context内协程的调度策略, lifo时被唤醒的协程在当前任务让出后立即执行
+    detail::schedule_strategy schedule{config::kScheduleStrategy};
+    // context每轮最多执行的任务数, 用尽后先收割已完成的IO再继续执行剩余任务, 0表示不限制
+    size_t task_budget{config::kTaskBudget};
+    // context每轮执行任务的最长时间(微秒), 用尽后先收割已完成的IO, 0表示不限制
+    uint64_t task_time_budget_us{config::kTaskTimeBudgetUs};
+    // 每轮保证每个优先级队列至少执行的任务数, 不受task_budget与task_time_budget_us限制, 0表示严格优先级
+    size_t prio_quota{config::kPrioQuota};
+};
+
+/**
+ * @brief scheduler的运行时参数, 同一进程中的多个scheduler可以使用不同的参数
+ */
+struct scheduler_options
+{
+    // context数量, 0表示使用硬件线程数
+    size_t ctx_cnt{0};
+    // 是否把每个context绑定到一个CPU上, CPU按NUMA节点交错分配, context数量少于CPU时各节点均衡
+    bool pin_cpu{config::kEnableCpuPinning};
+    // 每个context的engine参数
+    engine_options engine_opts{};
+};
+
+}; // namespace coro
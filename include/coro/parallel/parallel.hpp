@@ -0,0 +1,235 @@
+/**
+* @file parallel.hpp
+* @author daguai
+* @version 1.0
+*/
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <concepts>
+#include <cstddef>
+#include <ranges>
+#include <utility>
+#include <vector>
+
+#include "config.h"
+#include "coro/attribute.hpp"
+#include "coro/comp/when_all.hpp"
+#include "coro/scheduler.hpp"
+#include "coro/task.hpp"
+
+namespace coro
+{
+namespace detail
+{
+/**
+ * @brief parallel_for/parallel_reduce的分块状态, 各worker通过CAS领取下一块
+ *
+ * 块大小按剩余工作量自适应(guided): 开始时块较大以减少领取次数, 接近结束时块变小以平衡各worker的负载,
+ * 但不会小于grain.
+ */
+class parallel_range
+{
+public:
+    parallel_range(size_t size, size_t grain, size_t workers) noexcept
+        : m_last(size),
+          m_grain(std::max<size_t>(grain, 1)),
+          m_div(std::max<size_t>(workers, 1) * config::kParallelChunkFactor)
+    {
+    }
+
+    CORO_NO_COPY_MOVE(parallel_range);
+
+    /**
+     * @brief 领取下一块[begin, end)
+     *
+     * @return 没有剩余的块时返回false
+     */
+    auto claim(size_t& begin, size_t& end) noexcept -> bool
+    {
+        auto cur = m_next.load(std::memory_order_relaxed);
+        while (cur < m_last)
+        {
+            auto remaining = m_last - cur;
+            auto chunk     = std::min(remaining, std::max(m_grain, remaining / m_div));
+            if (m_next.compare_exchange_weak(cur, cur + chunk, std::memory_order_relaxed, std::memory_order_relaxed))
+            {
+                begin = cur;
+                end   = cur + chunk;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * @brief 放弃全部剩余的块, 某个worker抛出异常时调用
+     */
+    inline auto cancel() noexcept -> void { m_next.store(m_last, std::memory_order_relaxed); }
+
+    /**
+     * @brief worker数量, 每个context至多一个, 也不超过块的数量
+     */
+    static auto worker_num(size_t size, size_t grain) noexcept -> size_t
+    {
+        grain = std::max<size_t>(grain, 1);
+        return std::max<size_t>(1, std::min(scheduler::context_count(), (size + grain - 1) / grain));
+    }
+
+private:
+    CORO_ALIGN std::atomic<size_t> m_next{0};
+    size_t                         m_last;
+    size_t                         m_grain;
+    size_t                         m_div;
+};
+
+template<typename func_type>
+auto parallel_for_worker(parallel_range& range, func_type& fn) -> task<>
+{
+    size_t begin = 0;
+    size_t end   = 0;
+    try
+    {
+        while (range.claim(begin, end))
+        {
+            for (auto i = begin; i < end; i++)
+            {
+                fn(i);
+            }
+        }
+    }
+    catch (...)
+    {
+        range.cancel();
+        throw;
+    }
+    co_return;
+}
+
+template<typename value_type, typename transform_type, typename reduce_type>
+auto parallel_reduce_worker(parallel_range& range, value_type init, transform_type& transform, reduce_type& reduce)
+    -> task<value_type>
+{
+    size_t     begin = 0;
+    size_t     end   = 0;
+    value_type acc   = std::move(init);
+    try
+    {
+        while (range.claim(begin, end))
+        {
+            for (auto i = begin; i < end; i++)
+            {
+                acc = reduce(std::move(acc), transform(i));
+            }
+        }
+    }
+    catch (...)
+    {
+        range.cancel();
+        throw;
+    }
+    co_return acc;
+}
+}; // namespace detail
+
+/**
+ * @brief 把[first, last)分块后分发到scheduler的每个context上并行执行fn(i), 全部完成后返回
+ *
+ * 每个context只创建一个worker协程, worker循环领取大小自适应的块, 不会为每个元素或每个块创建协程帧.
+ * fn抛出异常时剩余的块被放弃, 异常在co_await处重新抛出.
+ *
+ * @param grain 最小块大小, 单个元素开销越小应取越大的值
+ */
+template<std::integral index_type, typename func_type>
+auto parallel_for(index_type first, index_type last, size_t grain, func_type fn) -> task<>
+{
+    if (last <= first)
+    {
+        co_return;
+    }
+
+    auto                  size = static_cast<size_t>(last - first);
+    auto                  num  = detail::parallel_range::worker_num(size, grain);
+    detail::parallel_range range(size, grain, num);
+
+    auto body = [&fn, first](size_t i) { fn(static_cast<index_type>(first + static_cast<index_type>(i))); };
+
+    std::vector<task<>> workers;
+    workers.reserve(num);
+    for (size_t i = 0; i < num; i++)
+    {
+        workers.push_back(detail::parallel_for_worker(range, body));
+    }
+    co_await when_all(spread, std::move(workers));
+}
+
+/**
+ * @brief 对随机访问range的每个元素并行执行fn(elem)
+ */
+template<std::ranges::random_access_range range_type, typename func_type>
+auto parallel_for(range_type& range, size_t grain, func_type fn) -> task<>
+{
+    auto it = std::ranges::begin(range);
+    co_await parallel_for(
+        size_t{0}, static_cast<size_t>(std::ranges::size(range)), grain, [&fn, it](size_t i) { fn(it[i]); });
+}
+
+/**
+ * @brief 并行计算 reduce(...reduce(init, transform(first))..., transform(last - 1))
+ *
+ * 每个worker从init开始在本地累加, 最后在等待者上合并各worker的部分结果,
+ * 因此init必须是reduce的单位元, reduce需要满足结合律与交换律.
+ */
+template<std::integral index_type, typename value_type, typename transform_type, typename reduce_type>
+auto parallel_reduce(
+    index_type first, index_type last, size_t grain, value_type init, transform_type transform, reduce_type reduce)
+    -> task<value_type>
+{
+    if (last <= first)
+    {
+        co_return init;
+    }
+
+    auto                  size = static_cast<size_t>(last - first);
+    auto                  num  = detail::parallel_range::worker_num(size, grain);
+    detail::parallel_range range(size, grain, num);
+
+    auto body = [&transform, first](size_t i)
+    { return transform(static_cast<index_type>(first + static_cast<index_type>(i))); };
+
+    std::vector<task<value_type>> workers;
+    workers.reserve(num);
+    for (size_t i = 0; i < num; i++)
+    {
+        workers.push_back(detail::parallel_reduce_worker(range, init, body, reduce));
+    }
+    auto partials = co_await when_all(spread, std::move(workers));
+
+    value_type result = std::move(init);
+    for (auto& partial : partials)
+    {
+        result = reduce(std::move(result), std::move(partial));
+    }
+    co_return result;
+}
+
+/**
+ * @brief 对随机访问range的每个元素并行计算transform(elem)并用reduce合并
+ */
+template<std::ranges::random_access_range range_type, typename value_type, typename transform_type, typename reduce_type>
+auto parallel_reduce(range_type& range, size_t grain, value_type init, transform_type transform, reduce_type reduce)
+    -> task<value_type>
+{
+    auto it  = std::ranges::begin(range);
+    auto res = co_await parallel_reduce(
+        size_t{0},
+        static_cast<size_t>(std::ranges::size(range)),
+        grain,
+        std::move(init),
+        [&transform, it](size_t i) { return transform(it[i]); },
+        std::move(reduce));
+    co_return res;
+}
+
+}; // namespace coro
@@ -3,6 +3,7 @@
 #include <atomic>
 #include <coroutine>
 #include <memory>
+#include <mutex>
 #include <sched.h>
 #include <thread>
 #include <vector>
@@ -11,61 +12,277 @@
 #include "config.h.in"
 #include "coro/detail/atomic_helper.hpp"
 #include "coro/dispatcher.hpp"
+#include "coro/attribute.hpp"
+#include "coro/future.hpp"
+#include "coro/options.hpp"
 
 namespace coro
 {
 
+/**
+* @brief 调度器, 管理一组context
+*
+* 静态接口作用于当前scheduler: 在工作线程上调用时为该线程所属的scheduler, 否则为全局默认的scheduler.
+* 也可以按scheduler_options创建多个独立的实例, 例如分别为控制流量与数据流量使用不同大小的io_uring,
+* 实例上运行的任务调用静态接口(submit, spawn, switch_to等)时仍然提交到该实例.
+*/
 class scheduler
 {
     friend context;
     using stop_token_type = std::atomic<int>;
     using stop_flag_type  = std::vector<detail::atomic_ref_wrapper<int>>;
 public:
+    /**
+    * @brief 按参数创建并初始化一个独立的scheduler, 之后通过post/launch提交任务, 通过run运行
+    */
+    explicit scheduler(const scheduler_options& opts) noexcept { init_impl(opts); }
+
+    ~scheduler() noexcept = default;
+
+    CORO_NO_COPY_MOVE(scheduler);
+
     inline static auto init(size_t ctx_cnt = std::thread::hardware_concurrency()) noexcept -> void
     {
-        if (ctx_cnt == 0)
-        {
-            ctx_cnt = std::thread::hardware_concurrency();
-        }
-        get_instance()->init_impl(ctx_cnt);
+        get_instance()->init_impl(scheduler_options{.ctx_cnt = ctx_cnt});
     }
 
     /**
-    * @brief 轮询直到所有的context完成工作
+    * @brief 按参数初始化默认的scheduler
+    */
+    inline static auto init(const scheduler_options& opts) noexcept -> void { get_instance()->init_impl(opts); }
+
+    /**
+    * @brief 轮询直到默认scheduler的所有context完成工作, 返回后可以继续提交任务并再次调用loop
     */
     inline static auto loop() noexcept -> void { get_instance()->loop_impl(); }
 
-    static inline auto submit(task<void>&& task) noexcept -> void
+    /**
+    * @brief 当前scheduler, 工作线程上为其所属的scheduler, 否则为默认的scheduler
+    */
+    inline static auto current() noexcept -> scheduler&
+    {
+        if (detail::is_in_working_state() && local_context().get_scheduler() != nullptr)
+        {
+            return *local_context().get_scheduler();
+        }
+        return *get_instance();
+    }
+
+    /**
+    * @brief 提交任务, 由dispatcher选择目标context
+    *
+    * @param prio 任务在目标context中的优先级
+    */
+    static inline auto submit(task<void>&& task, task_priority prio = task_priority::normal) noexcept -> void
     {
         auto handle = task.handle();
         task.detach();
-        submit(handle);
+        submit(handle, prio);
     }
 
     static inline auto submit(task<void>& task) noexcept -> void { submit(task.handle()); }
 
-    inline static auto submit(std::coroutine_handle<> handle) noexcept -> void
+    inline static auto submit(std::coroutine_handle<> handle, task_priority prio = task_priority::normal) noexcept
+        -> void
+    {
+        current().submit_task_impl(handle, prio);
+    }
+
+    /**
+    * @brief 提交任务到指定的context, 绕过dispatcher
+    *
+    * @param ctx_id 取值范围为[0, context_count())
+    */
+    static inline auto submit(task<void>&& task, size_t ctx_id, task_priority prio = task_priority::normal) noexcept
+        -> void
+    {
+        auto handle = task.handle();
+        task.detach();
+        submit(handle, ctx_id, prio);
+    }
+
+    inline static auto
+    submit(std::coroutine_handle<> handle, size_t ctx_id, task_priority prio = task_priority::normal) noexcept -> void
+    {
+        current().submit_task_impl(handle, ctx_id, prio);
+    }
+
+    /**
+    * @brief 提交一个有返回值的任务, 返回的future可以在协程中co_await, 也可以在非工作线程上阻塞等待
+    *
+    * 结果就绪之前scheduler不会结束运行, 即使所有context都已空闲
+    */
+    template<typename return_type>
+    [[CORO_DISCARD_HINT]] static auto spawn(task<return_type>&& task) -> future<return_type>
     {
-        get_instance()->submit_task_impl(handle);
+        return current().launch(std::move(task));
     }
 
+    /**
+    * @brief 同spawn, 任务提交到当前context, 子任务与父任务共享缓存与io_uring实例
+    *
+    * @note 只能在context中调用
+    */
+    template<typename return_type>
+    [[CORO_DISCARD_HINT]] static auto spawn_local(task<return_type>&& task) -> future<return_type>
+    {
+        assert(detail::is_in_working_state() && "spawn_local must be called in a context");
+        return spawn_on(local_context().get_index(), std::move(task));
+    }
+
+    /**
+    * @brief 同spawn, 任务提交到指定的context
+    *
+    * @param ctx_id 取值范围为[0, context_count())
+    */
+    template<typename return_type>
+    [[CORO_DISCARD_HINT]] static auto spawn_on(size_t ctx_id, task<return_type>&& task) -> future<return_type>
+    {
+        auto& sched = current();
+        auto  st    = std::make_shared<detail::future_state<return_type>>();
+        sched.post(sched.make_kept_task(std::move(task), st), ctx_id);
+        return future<return_type>(std::move(st));
+    }
+
+    /**
+    * @brief 判断工作线程是否正在运行, 即loop已经调用且尚未返回
+    */
+    inline static auto is_running() noexcept -> bool
+    {
+        return current().running();
+    }
+
+    /**
+    * @brief 获取context数量
+    */
+    inline static auto context_count() noexcept -> size_t { return current().size(); }
+
+    /**
+    * @brief 运行该scheduler直到所有的context完成工作, 阻塞调用线程, 返回后可以再次运行
+    */
+    inline auto run() noexcept -> void { loop_impl(); }
+
+    /**
+    * @brief 提交任务到该scheduler, 由dispatcher选择目标context
+    */
+    inline auto post(task<void>&& task, task_priority prio = task_priority::normal) noexcept -> void
+    {
+        auto handle = task.handle();
+        task.detach();
+        submit_task_impl(handle, prio);
+    }
+
+    /**
+    * @brief 提交任务到该scheduler的指定context
+    *
+    * @param ctx_id 取值范围为[0, size())
+    */
+    inline auto post(task<void>&& task, size_t ctx_id, task_priority prio = task_priority::normal) noexcept -> void
+    {
+        auto handle = task.handle();
+        task.detach();
+        submit_task_impl(handle, ctx_id, prio);
+    }
+
+    /**
+    * @brief 提交一个有返回值的任务到该scheduler, 同spawn
+    */
+    template<typename return_type>
+    [[CORO_DISCARD_HINT]] auto launch(task<return_type>&& task) -> future<return_type>
+    {
+        auto st = std::make_shared<detail::future_state<return_type>>();
+        post(make_kept_task(std::move(task), st));
+        return future<return_type>(std::move(st));
+    }
+
+    /**
+    * @brief 在非工作线程上执行task并阻塞等待其结果, 见sync_wait
+    *
+    * 提交前先持有停止计数的引用, 其他线程正在运行的loop在结果就绪前不会结束;
+    * 没有线程在运行时由调用线程运行loop
+    */
+    template<typename return_type>
+    auto block_on(task<return_type>&& task) -> return_type
+    {
+        assert(!detail::is_in_working_state() && "sync_wait would block a worker thread");
+        auto fut = launch(std::move(task));
+        if (try_start_loop())
+        {
+            run_loop();
+        }
+        return fut.get();
+    }
+
+    /**
+    * @brief 判断该scheduler的工作线程是否正在运行
+    */
+    inline auto running() const noexcept -> bool { return m_running.load(std::memory_order_acquire); }
+
+    /**
+    * @brief 该scheduler的context数量
+    */
+    inline auto size() const noexcept -> size_t { return m_ctx_cnt; }
+
+    /**
+    * @brief 初始化时使用的参数, ctx_cnt为实际的context数量
+    */
+    inline auto options() const noexcept -> const scheduler_options& { return m_opts; }
+
 private:
+    scheduler() noexcept = default;
+
     static auto get_instance() noexcept -> scheduler*
     {
         static scheduler sc;
         return &sc;
     }
 
-    auto init_impl(size_t ctx_cnt) noexcept -> void;
+    auto init_impl(const scheduler_options& opts) noexcept -> void;
 
     auto start_impl() noexcept -> void;
 
     auto loop_impl() noexcept -> void;
 
+    /**
+    * @brief 标记loop开始运行, 已经在运行时返回false
+    */
+    auto try_start_loop() noexcept -> bool;
+
+    /**
+    * @brief 启动context并阻塞到所有context结束, 之后重置停止计数, 需要先调用try_start_loop
+    */
+    auto run_loop() noexcept -> void;
+
+    /**
+    * @brief 持有停止计数的一个引用, 持有期间scheduler不会结束运行
+    *
+    * 停止计数为0表示loop正在结束, 此时通过std::atomic::wait阻塞到loop重置计数后再持有
+    */
+    auto acquire_keep_alive() noexcept -> void;
+
+    /**
+    * @brief 释放acquire_keep_alive持有的引用, 最后一个引用释放时停止所有context
+    */
+    auto release_keep_alive() noexcept -> void;
+
+    /**
+    * @brief 包装写入future的任务, 任务结束前持有停止计数的引用
+    */
+    template<typename return_type>
+    auto make_kept_task(task<return_type>&& t, std::shared_ptr<detail::future_state<return_type>> st) -> task<void>
+    {
+        acquire_keep_alive();
+        return detail::make_future_task(std::move(t), std::move(st), [this]() noexcept { release_keep_alive(); });
+    }
+
     auto stop_impl() noexcept -> void;
 
-    auto submit_task_impl(std::coroutine_handle<> handle) noexcept -> void;
+    auto submit_task_impl(std::coroutine_handle<> handle, task_priority prio) noexcept -> void;
+
+    auto submit_task_impl(std::coroutine_handle<> handle, size_t ctx_id, task_priority prio) noexcept -> void;
 private:
+    // 初始化参数
+    scheduler_options     m_opts;
     // 上下文数量
     size_t                m_ctx_cnt{0};
     // 存放context的容器
@@ -79,11 +296,56 @@ private:
 
     // 全局计数器,为0时可以停止scheduler
     stop_token_type m_stop_token;
+
+    // loop是否正在运行
+    std::atomic<bool> m_running{false};
+
+    // 保护loop的开始与结束时的停止计数重置, 使sync_wait不会错过正在结束的loop
+    std::mutex m_loop_mtx;
+
+    // 各context的io_uring通过ATTACH_WQ共享的io_uring描述符
+    CORO_ALIGN std::atomic<int> m_wq_fd{-1};
 };
 
-inline void submit_to_scheduler(task<void>&& task) noexcept
+namespace detail
+{
+/**
+ * @brief 把当前协程迁移到目标context上继续执行, 已经在目标context上时不挂起
+ */
+struct [[CORO_AWAIT_HINT]] switch_awaiter
 {
-    scheduler::submit(std::move(task));
+    explicit switch_awaiter(size_t ctx_id) noexcept : m_ctx_id(ctx_id) {}
+
+    auto await_ready() const noexcept -> bool
+    {
+        return is_in_working_state() && local_context().get_index() == m_ctx_id;
+    }
+
+    // 迁移后保持原有的优先级
+    auto await_suspend(std::coroutine_handle<> handle) noexcept -> void
+    {
+        scheduler::submit(handle, m_ctx_id, linfo.prio);
+    }
+
+    constexpr auto await_resume() const noexcept -> void {}
+
+    size_t m_ctx_id;
+};
+}; // namespace detail
+
+/**
+* @brief 迁移当前协程到指定的context, 用法: co_await switch_to(ctx_id);
+*
+* @param ctx_id 取值范围为[0, context_count())
+*/
+inline auto switch_to(size_t ctx_id) noexcept -> detail::switch_awaiter
+{
+    return detail::switch_awaiter(ctx_id);
+}
+
+inline void submit_to_scheduler(task<void>&& task, task_priority prio = task_priority::normal) noexcept
+{
+    scheduler::submit(std::move(task), prio);
 }
 
 inline void submit_to_scheduler(task<void>& task) noexcept
@@ -96,4 +358,27 @@ inline void submit_to_scheduler(std::coroutine_handle<> handle) noexcept
     scheduler::submit(handle);
 }
 
+/**
+* @brief 在非工作线程上执行task并阻塞等待其结果
+*
+* scheduler已经在其他线程中loop时只阻塞等待该任务, 该loop在任务结束前不会返回;
+* 否则在当前线程调用loop直到全部任务结束. loop返回后scheduler可以再次运行,
+* 因此同一个scheduler上可以多次调用sync_wait, 也可以在多个线程上同时调用.
+* 调用前需要先调用 scheduler::init
+*/
+template<typename return_type>
+auto sync_wait(task<return_type>&& task) -> return_type
+{
+    return scheduler::current().block_on(std::move(task));
+}
+
+/**
+* @brief 同sync_wait, 任务在指定的scheduler上执行
+*/
+template<typename return_type>
+auto sync_wait(scheduler& sched, task<return_type>&& task) -> return_type
+{
+    return sched.block_on(std::move(task));
+}
+
 }; // namespace coro
@@ -0,0 +1,228 @@
+/**
+* @file sharded.hpp
+* @author daguai
+* @version 1.0
+*/
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "coro/attribute.hpp"
+#include "coro/comp/when_all.hpp"
+#include "coro/context.hpp"
+#include "coro/scheduler.hpp"
+#include "coro/task.hpp"
+
+namespace coro
+{
+namespace detail
+{
+template<typename T>
+struct is_task : std::false_type
+{
+};
+
+template<typename return_type>
+struct is_task<task<return_type>> : std::true_type
+{
+};
+
+/**
+ * @brief fn的返回值类型, 返回task<U>时为U
+ */
+template<typename func_type, typename... Args>
+struct invoke_result
+{
+    using raw_type = std::invoke_result_t<func_type, Args...>;
+    using type     = raw_type;
+};
+
+template<typename func_type, typename... Args>
+    requires is_task<std::invoke_result_t<func_type, Args...>>::value
+struct invoke_result<func_type, Args...>
+{
+    using type = decltype(std::declval<std::invoke_result_t<func_type, Args...>>().promise().result());
+};
+
+template<typename func_type, typename... Args>
+using invoke_result_t = std::remove_cvref_t<typename invoke_result<func_type, Args...>::type>;
+}; // namespace detail
+
+/**
+ * @brief 在指定的context上执行fn并返回其结果, 结束后回到调用者所在的context, 用法:
+ *   auto res = co_await invoke_on(ctx_id, [&]() { return ...; });
+ *
+ * fn可以是普通函数, 也可以返回task. fn抛出的异常在回到调用者的context后重新抛出.
+ *
+ * @note 只能在context中调用
+ */
+template<typename func_type>
+auto invoke_on(size_t ctx_id, func_type fn) -> task<detail::invoke_result_t<func_type>>
+{
+    using result_type = detail::invoke_result_t<func_type>;
+    using raw_type    = std::invoke_result_t<func_type>;
+
+    auto origin = local_context().get_index();
+    co_await switch_to(ctx_id);
+
+    std::exception_ptr exception_ptr{nullptr};
+    if constexpr (std::is_void_v<result_type>)
+    {
+        try
+        {
+            if constexpr (detail::is_task<raw_type>::value)
+            {
+                co_await fn();
+            }
+            else
+            {
+                fn();
+            }
+        }
+        catch (...)
+        {
+            exception_ptr = std::current_exception();
+        }
+        co_await switch_to(origin);
+        if (exception_ptr)
+        {
+            std::rethrow_exception(exception_ptr);
+        }
+    }
+    else
+    {
+        std::optional<result_type> res;
+        try
+        {
+            if constexpr (detail::is_task<raw_type>::value)
+            {
+                auto val = co_await fn();
+                res.emplace(std::move(val));
+            }
+            else
+            {
+                res.emplace(fn());
+            }
+        }
+        catch (...)
+        {
+            exception_ptr = std::current_exception();
+        }
+        co_await switch_to(origin);
+        if (exception_ptr)
+        {
+            std::rethrow_exception(exception_ptr);
+        }
+        co_return std::move(*res);
+    }
+}
+
+/**
+ * @brief thread-per-core模式下的分片容器, 每个context持有一个独立的T实例
+ *
+ * 实例只由所属的context访问, 因此T内部不需要原子变量或锁, 跨context的访问通过invoke_on
+ * 把计算迁移到实例所属的context上完成. 各实例按缓存行对齐, 避免相邻实例之间的伪共享.
+ *
+ * @note 需要在scheduler::init之后构造, 分片数量等于context数量, 分片i属于context i
+ */
+template<typename T>
+class sharded
+{
+    struct CORO_ALIGN shard
+    {
+        template<typename... Args>
+        explicit shard(Args&&... args) : value(std::forward<Args>(args)...)
+        {
+        }
+
+        T value;
+    };
+
+public:
+    /**
+     * @brief 为每个context构造一个实例, 每个实例都使用相同的构造参数
+     */
+    template<typename... Args>
+    explicit sharded(const Args&... args)
+    {
+        auto num = scheduler::context_count();
+        m_shards.reserve(num);
+        for (size_t i = 0; i < num; i++)
+        {
+            m_shards.push_back(std::make_unique<shard>(args...));
+        }
+    }
+
+    CORO_NO_COPY_MOVE(sharded);
+
+    ~sharded() = default;
+
+    /**
+     * @brief 分片数量
+     */
+    inline auto size() const noexcept -> size_t { return m_shards.size(); }
+
+    /**
+     * @brief 当前context的实例
+     *
+     * @note 只能在context中调用
+     */
+    inline auto local() noexcept -> T&
+    {
+        assert(detail::is_in_working_state() && "sharded::local must be called in a context");
+        return get(local_context().get_index());
+    }
+
+    /**
+     * @brief 直接获取分片实例, 调用者需要保证不会与所属的context并发访问
+     */
+    inline auto get(size_t shard_id) noexcept -> T&
+    {
+        assert(shard_id < m_shards.size() && "shard id out of range");
+        return m_shards[shard_id]->value;
+    }
+
+    /**
+     * @brief 在分片所属的context上执行fn(T&), 用法: auto res = co_await s.invoke_on(id, fn);
+     */
+    template<typename func_type>
+    auto invoke_on(size_t shard_id, func_type fn) -> task<detail::invoke_result_t<func_type, T&>>
+    {
+        auto& value = get(shard_id);
+        return ::coro::invoke_on(shard_id, [&value, fn = std::move(fn)]() mutable { return fn(value); });
+    }
+
+    /**
+     * @brief 在每个分片所属的context上并发执行fn(T&), 全部完成后返回
+     */
+    template<typename func_type>
+    auto invoke_on_all(func_type fn) -> task<>
+    {
+        std::vector<task<>> tasks;
+        tasks.reserve(size());
+        for (size_t i = 0; i < size(); i++)
+        {
+            tasks.push_back(invoke_void_on(i, fn));
+        }
+        co_await when_all(std::move(tasks));
+    }
+
+private:
+    template<typename func_type>
+    auto invoke_void_on(size_t shard_id, func_type& fn) -> task<>
+    {
+        auto& value = get(shard_id);
+        co_await ::coro::invoke_on(shard_id, [&value, &fn]() { return fn(value); });
+    }
+
+    std::vector<std::unique_ptr<shard>> m_shards;
+};
+
+}; // namespace coro
@@ -13,6 +13,7 @@
 #include <utility>
 
 #include "coro/detail/container.hpp"
+#include "coro/meta_info.hpp"
 
 namespace coro
 {
@@ -30,6 +31,23 @@ enum class coro_state : uint8_t
     none
 };
 
+/**
+ * @brief 子任务结束时的通知接口, 由when_all/when_any等组合器实现
+ */
+struct task_notifier
+{
+    /**
+     * @brief 在子任务的final_suspend中调用
+     *
+     * @return 需要对称转移执行的协程句柄, 没有时返回std::noop_coroutine()
+     * @note 调用之后子任务的协程帧可能随时被组合器销毁
+     */
+    virtual auto on_task_done(std::coroutine_handle<> handle) noexcept -> std::coroutine_handle<> = 0;
+
+protected:
+    ~task_notifier() = default;
+};
+
 struct promise_base
 {
     promise_base() noexcept = default;
@@ -44,7 +62,17 @@ struct promise_base
         {
             // If there is a continuation call it, otherwise this is the end of the line.
             auto& promise = coroutine.promise();
-            return promise.m_continuation != nullptr ? promise.m_continuation : std::noop_coroutine();
+            if (promise.m_notifier != nullptr)
+            {
+                return promise.m_notifier->on_task_done(coroutine);
+            }
+            if (promise.m_continuation != nullptr)
+            {
+                return promise.m_continuation;
+            }
+            // 记录结束的顶层协程, engine恢复的可能是嵌套的子协程, 只能通过这里得知需要清理的句柄
+            linfo.finished = coroutine;
+            return std::noop_coroutine();
         }
 
         constexpr auto await_resume() noexcept -> void {}
@@ -65,6 +93,9 @@ struct promise_base
     std::coroutine_handle<> m_continuation{nullptr};
     auto continuation(std::coroutine_handle<> continuation) noexcept -> void { m_continuation = continuation; }
 
+    task_notifier* m_notifier{nullptr};
+    auto notifier(task_notifier* notifier) noexcept -> void { m_notifier = notifier; }
+
 
 #ifdef DEBUG
 public:
@@ -1,10 +1,12 @@
 #pragma once
 
 #include <cassert>
+#include <cerrno>
 #include <cstdlib>
 #include <cstring>
 #include <functional>
 #include <liburing.h>
+#include <poll.h>
 #include <sys/eventfd.h>
 #include <vector>
 // #ifdef ENABLE_SQPOOL
@@ -33,32 +35,60 @@ public:
     uring_proxy() noexcept
     {
         // must init in construct func
-        m_efd = eventfd(0, 0);
-        if (m_efd < 0)
+        open_eventfd();
+    }
+
+    ~uring_proxy() noexcept
+    {
+        if (m_efd >= 0)
         {
-            // log::error("uring_proxy init event_fd failed");
-            std::exit(1);
+            close(m_efd);
         }
     }
 
-    ~uring_proxy() noexcept = default;
-
-    auto init(unsigned int entry_length) noexcept -> void
+    /**
+     * @brief 创建io_uring实例
+     *
+     * @param sqpoll 是否启用IORING_SETUP_SQPOLL
+     * @param sq_thread_idle SQPOLL内核线程空闲多久后休眠(毫秒)
+     * @param wq_fd 大于等于0时通过IORING_SETUP_ATTACH_WQ共享该io_uring的io-wq线程池, 失败时退化为独立创建
+     */
+    auto init(
+        unsigned int entry_length,
+        bool         sqpoll         = false,
+        unsigned int sq_thread_idle = config::kSqthreadIdle,
+        int          wq_fd          = -1) noexcept -> void
     {
         // don't need to set m_para
         memset(&m_para, 0, sizeof(m_para));
 
-#ifdef ENABLE_SQPOOL
-        m_para.flags |= IORING_SETUP_SQPOLL;
-        m_para.sq_thread_idle = config::kSqthreadIdle;
-#endif // ENABLE_SQPOOL
+        if (sqpoll)
+        {
+            m_para.flags |= IORING_SETUP_SQPOLL;
+            m_para.sq_thread_idle = sq_thread_idle;
+        }
+        auto para = m_para;
 
-        auto res = io_uring_queue_init_params(entry_length, &m_uring, &m_para);
+        int res = -1;
+        if (wq_fd >= 0)
+        {
+            m_para.flags |= IORING_SETUP_ATTACH_WQ;
+            m_para.wq_fd = wq_fd;
+            res          = io_uring_queue_init_params(entry_length, &m_uring, &m_para);
+            m_attached   = res == 0;
+        }
+        if (res != 0)
+        {
+            // 被共享的io_uring已经关闭或内核不支持ATTACH_WQ
+            m_para = para;
+            res    = io_uring_queue_init_params(entry_length, &m_uring, &m_para);
+        }
         if (res != 0)
         {
             // log::error("uring_proxy init uring failed");
             std::exit(1);
         }
+        m_ring_ready = true;
 
         res = io_uring_register_eventfd(&m_uring, m_efd);
         if (res != 0)
@@ -99,20 +129,41 @@ public:
     {
         // this operation cost too much time, so don't call this function
         // io_uring_unregister_eventfd(&m_uring);
-        close(m_efd);
-        m_efd = -1;
-
-        if constexpr (config::kEnableFixfd)
+        if (m_ring_ready)
         {
-            for (auto fd : m_null_fds)
+            if constexpr (config::kEnableFixfd)
             {
-                close(fd);
+                for (auto fd : m_null_fds)
+                {
+                    close(fd);
+                }
             }
+
+            io_uring_queue_exit(&m_uring);
+            m_ring_ready = false;
+            m_attached   = false;
         }
 
-        io_uring_queue_exit(&m_uring);
+        // 其他线程的wake_up可能与deinit并发, eventfd在proxy的整个生命周期内保持打开,
+        // 这里只清空本次运行遗留的计数, 再次init时注册到新的io_uring
+        [[CORO_MAYBE_UNUSED]] auto _ = try_read_eventfd();
     }
 
+    /**
+     * @brief io_uring实例是否已经创建
+     */
+    inline auto ring_ready() const noexcept -> bool { return m_ring_ready; }
+
+    /**
+     * @brief io_uring实例是否与其他io_uring共享io-wq线程池
+     */
+    inline auto wq_attached() const noexcept -> bool { return m_attached; }
+
+    /**
+     * @brief io_uring实例的文件描述符, 用于其他io_uring的ATTACH_WQ
+     */
+    inline auto ring_fd() const noexcept -> int { return m_uring.ring_fd; }
+
     /**
      * @brief return if uring has finished io
      *
@@ -202,11 +253,32 @@ public:
         return i;
     }
 
+    /**
+     * @brief 阻塞读取并清空eventfd的计数
+     */
     auto wait_eventfd() noexcept -> uint64_t
     {
         uint64_t u;
-        auto     ret = eventfd_read(m_efd, &u);
-        assert(ret != -1 && "eventfd read error");
+        while (eventfd_read(m_efd, &u) != 0)
+        {
+            assert((errno == EAGAIN || errno == EINTR) && "eventfd read error");
+            pollfd pfd{.fd = m_efd, .events = POLLIN, .revents = 0};
+            ::poll(&pfd, 1, -1);
+        }
+        return u;
+    }
+
+    /**
+     * @brief 不阻塞地读取并清空eventfd的计数, 计数为0时返回0
+     */
+    auto try_read_eventfd() noexcept -> uint64_t
+    {
+        uint64_t u;
+        if (eventfd_read(m_efd, &u) != 0)
+        {
+            assert(errno == EAGAIN && "eventfd read error");
+            return 0;
+        }
         return u;
     }
 
@@ -224,8 +296,9 @@ public:
 
     inline auto write_eventfd(uint64_t num) noexcept -> void //TODO:
     {
+        // 计数将要溢出时返回EAGAIN, 此时eventfd一定可读, 读取方必然会被唤醒
         auto ret = eventfd_write(m_efd, num);
-        assert(ret != -1 && "eventfd write error");
+        assert((ret != -1 || errno == EAGAIN) && "eventfd write error");
     }
 
     /**
@@ -284,10 +357,57 @@ public:
         }
     }
 
+    /**
+     * @brief register a provided buffer ring to uring
+     *
+     * @param entries must be power of 2
+     * @param bgid buffer group id
+     * @param ret errno if failed
+     * @return io_uring_buf_ring*, nullptr if failed
+     */
+    inline auto setup_buf_ring(unsigned int entries, int bgid, int* ret) noexcept -> io_uring_buf_ring*
+    {
+        return io_uring_setup_buf_ring(&m_uring, entries, bgid, 0, ret);
+    }
+
+    /**
+     * @brief unregister and free provided buffer ring
+     *
+     * @param br
+     * @param entries
+     * @param bgid
+     */
+    inline auto free_buf_ring(io_uring_buf_ring* br, unsigned int entries, int bgid) noexcept -> void
+    {
+        io_uring_free_buf_ring(&m_uring, br, entries, bgid);
+    }
+
+    /**
+     * @brief get an unused buffer group id
+     *
+     * @return int
+     */
+    inline auto alloc_buf_group_id() noexcept -> int { return m_next_bgid++; }
+
+private:
+    auto open_eventfd() noexcept -> void
+    {
+        // 非阻塞: 写入方不会因计数溢出而阻塞, 工作线程可以在不睡眠的情况下清空计数
+        m_efd = eventfd(0, EFD_NONBLOCK);
+        if (m_efd < 0)
+        {
+            // log::error("uring_proxy init event_fd failed");
+            std::exit(1);
+        }
+    }
+
 private:
     int             m_efd{0};
     io_uring_params m_para;
     io_uring        m_uring;
+    int             m_next_bgid{0};
+    bool            m_ring_ready{false}; // io_uring实例是否已经创建
+    bool            m_attached{false};   // 是否通过ATTACH_WQ共享了io-wq线程池
 
     // Use m_fds to utilize the IOSQE_FIXED_FILE feature of io_uring
     std::vector<int>                                            m_null_fds;
@@ -1,10 +1,12 @@
 #pragma once
 
 #include <chrono>
+#include <cstddef>
 #include <cstdint>
 #include <regex>
 #include <string>
 #include <thread>
+#include <vector>
 
 namespace coro::utils 
 {
@@ -23,6 +25,32 @@ auto set_fd_noblock(int fd) noexcept -> void;
  */
 auto get_null_fd() noexcept -> int;
 
+/**
+ * @brief 在[data, data + len)中查找字节c, 按CPU能力选择AVX2/SSE2实现, 否则退化为逐字节扫描
+ *
+ * @return c第一次出现的下标, 未找到时返回len
+ */
+auto find_byte(const char* data, size_t len, char c) noexcept -> size_t;
+
+/**
+ * @brief 获取当前进程允许运行的CPU编号, 按从小到大排列
+ */
+auto get_allowed_cpus() noexcept -> std::vector<int>;
+
+/**
+ * @brief 把调用线程绑定到指定的CPU上
+ *
+ * @return 绑定是否成功
+ */
+auto pin_thread_to_cpu(int cpu) noexcept -> bool;
+
+/**
+ * @brief 获取CPU所属的NUMA节点, 通过/sys/devices/system/cpu/cpu<N>/node<M>查询
+ *
+ * @return 节点编号, 无法获取时返回0
+ */
+auto get_numa_node(int cpu) noexcept -> int;
+
 inline auto sleep(int64_t t) noexcept -> void
 {
     std::this_thread::sleep_for(std::chrono::seconds(t));
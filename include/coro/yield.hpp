@@ -0,0 +1,44 @@
+/**
+* @file yield.hpp
+* @author daguai
+* @version 1.0
+*/
+#pragma once
+
+#include <coroutine>
+
+#include "coro/attribute.hpp"
+#include "coro/context.hpp"
+
+namespace coro
+{
+namespace detail
+{
+/**
+ * @brief 把当前协程放回所在context任务队列的末尾, 让队列中的其他任务与IO完成先得到执行
+ */
+struct [[CORO_AWAIT_HINT]] yield_awaiter
+{
+    constexpr auto await_ready() const noexcept -> bool { return false; }
+
+    // 不使用next slot, 否则让出的协程会在下一个任务之前再次执行, 重新入队时保持原有的优先级
+    auto await_suspend(std::coroutine_handle<> handle) noexcept -> void
+    {
+        local_context().submit_task(handle, linfo.prio);
+    }
+
+    constexpr auto await_resume() const noexcept -> void {}
+};
+}; // namespace detail
+
+/**
+ * @brief 主动让出执行权, 用于长时间运行的计算任务, 用法: co_await coro::yield();
+ *
+ * @note 只能在context中调用
+ */
+inline auto yield() noexcept -> detail::yield_awaiter
+{
+    return {};
+}
+
+}; // namespace coro
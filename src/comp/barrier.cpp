@@ -0,0 +1,96 @@
+#include "coro/comp/barrier.hpp"
+#include "coro/context.hpp"
+#include "coro/detail/resume_batch.hpp"
+#include "coro/scheduler.hpp"
+#include <cassert>
+#include <coroutine>
+#include <mutex>
+
+namespace coro
+{
+
+auto barrier::awaiter::await_suspend(std::coroutine_handle<> handle) noexcept -> bool
+{
+    awaiter* waiters = nullptr;
+    {
+        std::lock_guard<std::mutex> lk(m_bar.m_mtx);
+        m_generation = m_bar.m_generation;
+        if (!m_bar.arrive_locked(waiters))
+        {
+            m_await_coro = handle;
+            m_prio       = detail::linfo.prio;
+            m_ctx.register_wait();
+            m_next       = m_bar.m_head;
+            m_bar.m_head = this;
+            return true;
+        }
+    }
+    // 最后一个到达的协程不挂起, 负责结束本阶段
+    m_bar.complete_phase(waiters);
+    return false;
+}
+
+auto barrier::awaiter::await_resume() noexcept -> uint64_t
+{
+    // 只有真正挂起过的等待者需要在自己的context上撤销等待计数
+    if (m_await_coro != nullptr)
+    {
+        m_ctx.unregister_wait();
+    }
+    return m_generation;
+}
+
+auto barrier::arrive_and_wait() noexcept -> awaiter
+{
+    return awaiter(local_context(), *this);
+}
+
+auto barrier::arrive_and_drop() noexcept -> void
+{
+    awaiter* waiters = nullptr;
+    bool     done    = false;
+    {
+        std::lock_guard<std::mutex> lk(m_mtx);
+        m_dropped++;
+        done = arrive_locked(waiters);
+    }
+    if (done)
+    {
+        complete_phase(waiters);
+    }
+}
+
+auto barrier::generation() noexcept -> uint64_t
+{
+    std::lock_guard<std::mutex> lk(m_mtx);
+    return m_generation;
+}
+
+auto barrier::arrive_locked(awaiter*& waiters) noexcept -> bool
+{
+    assert(m_arrived < m_expected && "barrier arrivals exceed expected count");
+    if (++m_arrived < m_expected)
+    {
+        return false;
+    }
+
+    waiters = m_head;
+    m_head  = nullptr;
+    m_expected -= m_dropped;
+    m_arrived  = 0;
+    m_dropped  = 0;
+    m_generation++;
+    return true;
+}
+
+auto barrier::complete_phase(awaiter* waiters) noexcept -> void
+{
+    // 本阶段的其他协程都在等待, 下一个阶段不会在completion执行完之前开始
+    if (m_completion)
+    {
+        m_completion();
+    }
+    detail::resume_grouped(waiters);
+}
+
+}; // namespace coro
@@ -0,0 +1,80 @@
+#include "coro/comp/condition_variable.hpp"
+#include "coro/context.hpp"
+#include "coro/detail/resume_batch.hpp"
+#include "coro/scheduler.hpp"
+#include <coroutine>
+#include <mutex>
+
+namespace coro
+{
+
+auto condition_variable::awaiter::await_suspend(std::coroutine_handle<> handle) noexcept -> void
+{
+    m_await_coro = handle;
+    m_prio       = detail::linfo.prio;
+    m_ctx.register_wait();
+
+    // 入队后协程可能立即被唤醒并销毁awaiter, 先取出需要的成员
+    auto& mtx = m_mtx;
+    auto& cv  = m_cv;
+    {
+        std::lock_guard<std::mutex> lk(cv.m_mtx);
+        m_next = nullptr;
+        if (cv.m_tail == nullptr)
+        {
+            cv.m_head = cv.m_tail = this;
+        }
+        else
+        {
+            cv.m_tail->m_next = this;
+            cv.m_tail         = this;
+        }
+    }
+    mtx.unlock();
+}
+
+auto condition_variable::awaiter::await_resume() noexcept -> void
+{
+    m_ctx.unregister_wait();
+}
+
+auto condition_variable::wait(mutex& mtx) noexcept -> task<>
+{
+    co_await awaiter(local_context(), *this, mtx);
+    co_await mtx.lock();
+}
+
+auto condition_variable::notify_one() noexcept -> void
+{
+    awaiter* waiter = nullptr;
+    {
+        std::lock_guard<std::mutex> lk(m_mtx);
+        waiter = m_head;
+        if (waiter != nullptr)
+        {
+            m_head = waiter->m_next;
+            if (m_head == nullptr)
+            {
+                m_tail = nullptr;
+            }
+            waiter->m_next = nullptr;
+        }
+    }
+    if (waiter != nullptr)
+    {
+        detail::resume_grouped(waiter);
+    }
+}
+
+auto condition_variable::notify_all() noexcept -> void
+{
+    awaiter* head = nullptr;
+    {
+        std::lock_guard<std::mutex> lk(m_mtx);
+        head   = m_head;
+        m_head = m_tail = nullptr;
+    }
+    detail::resume_grouped(head);
+}
+
+}; // namespace coro
@@ -1,4 +1,5 @@
 #include "coro/comp/event.hpp"
+#include "coro/detail/resume_batch.hpp"
 #include "coro/scheduler.hpp"
 
 namespace coro::detail
@@ -12,6 +13,7 @@ auto event_base::awaiter_base::await_ready() noexcept -> bool
 auto event_base::awaiter_base::await_suspend(std::coroutine_handle<> handle) noexcept -> bool
 {
     m_await_coro = handle;
+    m_prio       = linfo.prio;
     return m_ev.register_awaiter(this);
 }
 
@@ -32,13 +34,8 @@ auto event_base::set_state() noexcept -> void
 
 auto event_base::resume_all_awaiter(awaiter_ptr waiter) noexcept -> void
 {
-    while (waiter != nullptr)
-    {
-        auto cur = static_cast<awaiter_base*>(waiter);
-        cur->m_ctx.submit_task(cur->m_await_coro);
-        // cur->m_ctx.unregister_wait();
-        waiter = cur->m_next;
-    }
+    // 按context分组批量提交, 每个目标context只唤醒一次
+    resume_grouped(static_cast<awaiter_base*>(waiter));
 }
 
 auto event_base::register_awaiter(awaiter_base* waiter) noexcept -> bool
@@ -0,0 +1,106 @@
+#include "coro/comp/mutex.hpp"
+#include "coro/context.hpp"
+#include "coro/scheduler.hpp"
+#include <atomic>
+#include <cassert>
+#include <coroutine>
+
+namespace coro
+{
+
+auto mutex::lock_awaiter::await_suspend(std::coroutine_handle<> handle) noexcept -> bool
+{
+    m_await_coro = handle;
+    m_prio       = detail::linfo.prio;
+    m_ctx.register_wait();
+
+    auto old_value = m_mtx.m_state.load(std::memory_order_acquire);
+    while (true)
+    {
+        if (old_value == m_mtx.unlocked_state())
+        {
+            // 锁在此期间被释放, 直接获取而不挂起
+            if (m_mtx.m_state.compare_exchange_weak(
+                    old_value, nullptr, std::memory_order_acquire, std::memory_order_relaxed))
+            {
+                m_ctx.unregister_wait();
+                m_await_coro = nullptr;
+                return false;
+            }
+        }
+        else
+        {
+            m_next = static_cast<lock_awaiter*>(old_value);
+            if (m_mtx.m_state.compare_exchange_weak(
+                    old_value, static_cast<awaiter_ptr>(this), std::memory_order_release, std::memory_order_acquire))
+            {
+                return true;
+            }
+        }
+    }
+}
+
+auto mutex::lock_awaiter::await_resume() noexcept -> void
+{
+    // 只有真正挂起过的等待者需要在自己的context上撤销等待计数
+    if (m_await_coro != nullptr)
+    {
+        m_ctx.unregister_wait();
+    }
+}
+
+auto mutex::lock_awaiter::resume() noexcept -> void
+{
+    // 等待计数由await_resume在等待者自己的线程上撤销, 以免该context错过空闲检查
+    m_ctx.submit_next(m_await_coro, m_prio);
+}
+
+auto mutex::try_lock() noexcept -> bool
+{
+    auto old_value = unlocked_state();
+    return m_state.compare_exchange_strong(old_value, nullptr, std::memory_order_acquire, std::memory_order_relaxed);
+}
+
+auto mutex::lock() noexcept -> lock_awaiter
+{
+    return lock_awaiter(local_context(), *this);
+}
+
+auto mutex::scoped_lock() noexcept -> scoped_lock_awaiter
+{
+    return scoped_lock_awaiter(local_context(), *this);
+}
+
+auto mutex::unlock() noexcept -> void
+{
+    assert(m_state.load(std::memory_order_relaxed) != unlocked_state());
+
+    auto to_resume = m_resume_list_head;
+    if (to_resume == nullptr)
+    {
+        awaiter_ptr old_value = nullptr;
+        if (m_state.compare_exchange_strong(
+                old_value, unlocked_state(), std::memory_order_release, std::memory_order_relaxed))
+        {
+            return;
+        }
+
+        // 取走整个等待者栈并翻转为FIFO顺序, 锁状态保持为已上锁
+        old_value = m_state.exchange(nullptr, std::memory_order_acquire);
+        assert(old_value != nullptr && old_value != unlocked_state());
+
+        auto cur = static_cast<lock_awaiter*>(old_value);
+        do
+        {
+            auto next   = cur->m_next;
+            cur->m_next = to_resume;
+            to_resume   = cur;
+            cur         = next;
+        } while (cur != nullptr);
+    }
+
+    m_resume_list_head = to_resume->m_next;
+    to_resume->resume();
+}
+
+}; // namespace coro
@@ -0,0 +1,96 @@
+#include "coro/comp/semaphore.hpp"
+#include "coro/context.hpp"
+#include "coro/detail/resume_batch.hpp"
+#include "coro/scheduler.hpp"
+#include <atomic>
+#include <coroutine>
+#include <mutex>
+
+namespace coro
+{
+
+auto counting_semaphore::acquire_awaiter::await_suspend(std::coroutine_handle<> handle) noexcept -> bool
+{
+    std::lock_guard<std::mutex> lk(m_sem.m_mtx);
+    // release在本协程入队前已经移交了许可
+    if (m_sem.m_pending > 0)
+    {
+        m_sem.m_pending--;
+        return false;
+    }
+
+    m_await_coro = handle;
+    m_prio       = detail::linfo.prio;
+    m_ctx.register_wait();
+    m_next = nullptr;
+    if (m_sem.m_tail == nullptr)
+    {
+        m_sem.m_head = m_sem.m_tail = this;
+    }
+    else
+    {
+        m_sem.m_tail->m_next = this;
+        m_sem.m_tail         = this;
+    }
+    return true;
+}
+
+auto counting_semaphore::acquire_awaiter::await_resume() noexcept -> void
+{
+    // 只有真正挂起过的等待者需要在自己的context上撤销等待计数
+    if (m_await_coro != nullptr)
+    {
+        m_ctx.unregister_wait();
+    }
+}
+
+auto counting_semaphore::try_acquire() noexcept -> bool
+{
+    auto count = m_count.load(std::memory_order_acquire);
+    while (count > 0)
+    {
+        if (m_count.compare_exchange_weak(count, count - 1, std::memory_order_acq_rel, std::memory_order_acquire))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+auto counting_semaphore::acquire() noexcept -> acquire_awaiter
+{
+    return acquire_awaiter(local_context(), *this);
+}
+
+auto counting_semaphore::release(int64_t update) noexcept -> void
+{
+    auto old_value = m_count.fetch_add(update, std::memory_order_acq_rel);
+    if (old_value >= 0)
+    {
+        return;
+    }
+
+    // 需要移交给等待者的许可数
+    auto             handoff = old_value + update < 0 ? update : -old_value;
+    acquire_awaiter* head    = nullptr;
+    {
+        std::lock_guard<std::mutex> lk(m_mtx);
+        acquire_awaiter** tail = &head;
+        while (handoff > 0 && m_head != nullptr)
+        {
+            *tail  = m_head;
+            tail   = &m_head->m_next;
+            m_head = m_head->m_next;
+            handoff--;
+        }
+        *tail = nullptr;
+        if (m_head == nullptr)
+        {
+            m_tail = nullptr;
+        }
+        m_pending += handoff;
+    }
+    detail::resume_grouped(head);
+}
+
+}; // namespace coro
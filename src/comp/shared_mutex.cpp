@@ -0,0 +1,192 @@
+#include "coro/comp/shared_mutex.hpp"
+#include "coro/context.hpp"
+#include "coro/scheduler.hpp"
+#include <atomic>
+#include <cassert>
+#include <coroutine>
+#include <mutex>
+
+namespace coro
+{
+
+auto shared_mutex::awaiter_base::await_resume() noexcept -> void
+{
+    // 只有真正挂起过的等待者需要在自己的context上撤销等待计数
+    if (m_await_coro != nullptr)
+    {
+        m_ctx.unregister_wait();
+    }
+}
+
+auto shared_mutex::awaiter_base::resume() noexcept -> void
+{
+    // 等待计数由await_resume在等待者自己的线程上撤销, 以免该context错过空闲检查
+    m_ctx.submit_next(m_await_coro, m_prio);
+}
+
+auto shared_mutex::lock_awaiter::await_suspend(std::coroutine_handle<> handle) noexcept -> bool
+{
+    m_await_coro = handle;
+    m_prio       = detail::linfo.prio;
+    m_ctx.register_wait();
+
+    std::lock_guard<std::mutex> lk(m_mtx.m_mtx);
+    auto                        state = m_mtx.m_state.load(std::memory_order_acquire);
+    while (true)
+    {
+        if ((state & ~kWaitingBit) == 0)
+        {
+            // 没有读者也没有写者持锁, 保留其他写者的等待标记直接获取
+            if (m_mtx.m_state.compare_exchange_weak(
+                    state, state | kWriterBit, std::memory_order_acquire, std::memory_order_acquire))
+            {
+                m_ctx.unregister_wait();
+                m_await_coro = nullptr;
+                return false;
+            }
+        }
+        else if (m_mtx.m_state.compare_exchange_weak(
+                     state, state | kWaitingBit, std::memory_order_acq_rel, std::memory_order_acquire))
+        {
+            // 等待标记设置后读者的快速路径失效, 最后一个释放读锁的协程会在m_mtx下看到本等待者
+            push_back(m_mtx.m_writer_head, m_mtx.m_writer_tail, this);
+            return true;
+        }
+    }
+}
+
+auto shared_mutex::lock_shared_awaiter::await_suspend(std::coroutine_handle<> handle) noexcept -> bool
+{
+    m_await_coro = handle;
+    m_prio       = detail::linfo.prio;
+    m_ctx.register_wait();
+
+    std::lock_guard<std::mutex> lk(m_mtx.m_mtx);
+    // 持有m_mtx时写锁的释放无法进行, 重新检查后入队不会丢失唤醒
+    if (m_mtx.try_lock_shared())
+    {
+        m_ctx.unregister_wait();
+        m_await_coro = nullptr;
+        return false;
+    }
+    push_back(m_mtx.m_reader_head, m_mtx.m_reader_tail, this);
+    return true;
+}
+
+auto shared_mutex::try_lock() noexcept -> bool
+{
+    uint64_t state = 0;
+    return m_state.compare_exchange_strong(state, kWriterBit, std::memory_order_acquire, std::memory_order_relaxed);
+}
+
+auto shared_mutex::try_lock_shared() noexcept -> bool
+{
+    auto state = m_state.load(std::memory_order_relaxed);
+    while ((state & (kWriterBit | kWaitingBit)) == 0)
+    {
+        if (m_state.compare_exchange_weak(state, state + 1, std::memory_order_acquire, std::memory_order_relaxed))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+auto shared_mutex::lock() noexcept -> lock_awaiter
+{
+    return lock_awaiter(local_context(), *this);
+}
+
+auto shared_mutex::lock_shared() noexcept -> lock_shared_awaiter
+{
+    return lock_shared_awaiter(local_context(), *this);
+}
+
+auto shared_mutex::unlock() noexcept -> void
+{
+    assert(m_state.load(std::memory_order_relaxed) & kWriterBit);
+
+    awaiter_base* to_resume = nullptr;
+    {
+        std::lock_guard<std::mutex> lk(m_mtx);
+        if (m_writer_head != nullptr)
+        {
+            to_resume = pop_writer();
+        }
+        else
+        {
+            // 没有等待的写者, 一次性把读锁授予全部等待的读者
+            uint64_t readers = 0;
+            for (auto cur = m_reader_head; cur != nullptr; cur = cur->m_next)
+            {
+                readers++;
+            }
+            to_resume     = m_reader_head;
+            m_reader_head = m_reader_tail = nullptr;
+            m_state.store(readers, std::memory_order_release);
+        }
+    }
+
+    while (to_resume != nullptr)
+    {
+        auto next = to_resume->m_next;
+        to_resume->resume();
+        to_resume = next;
+    }
+}
+
+auto shared_mutex::unlock_shared() noexcept -> void
+{
+    auto state = m_state.fetch_sub(1, std::memory_order_acq_rel) - 1;
+    assert(((state + 1) & kReaderMask) > 0);
+    if ((state & kReaderMask) != 0 || (state & kWaitingBit) == 0)
+    {
+        return;
+    }
+
+    // 最后一个读者离开且有写者在等待, 把写锁移交给队首的写者
+    awaiter_base* to_resume = nullptr;
+    {
+        std::lock_guard<std::mutex> lk(m_mtx);
+        // 期间可能有写者在慢路径中直接获取了写锁, 此时由它负责后续的移交
+        if (m_writer_head != nullptr && (m_state.load(std::memory_order_acquire) & ~kWaitingBit) == 0)
+        {
+            to_resume = pop_writer();
+        }
+    }
+    if (to_resume != nullptr)
+    {
+        to_resume->resume();
+    }
+}
+
+auto shared_mutex::push_back(awaiter_base*& head, awaiter_base*& tail, awaiter_base* waiter) noexcept -> void
+{
+    waiter->m_next = nullptr;
+    if (tail == nullptr)
+    {
+        head = tail = waiter;
+    }
+    else
+    {
+        tail->m_next = waiter;
+        tail         = waiter;
+    }
+}
+
+auto shared_mutex::pop_writer() noexcept -> awaiter_base*
+{
+    auto writer   = m_writer_head;
+    m_writer_head = writer->m_next;
+    if (m_writer_head == nullptr)
+    {
+        m_writer_tail = nullptr;
+    }
+    writer->m_next = nullptr;
+
+    // 调用者保证此时没有读者持锁且等待标记已设置, 快速路径都会失败, 没有其他路径能修改m_state
+    m_state.store(kWriterBit | (m_writer_head != nullptr ? kWaitingBit : 0), std::memory_order_release);
+    return writer;
+}
+
+}; // namespace coro
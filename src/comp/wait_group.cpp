@@ -1,5 +1,6 @@
 #include "coro/comp/wait_group.hpp"
 #include "coro/context.hpp"
+#include "coro/detail/resume_batch.hpp"
 #include "coro/scheduler.hpp"
 #include <atomic>
 #include <coroutine>
@@ -10,6 +11,7 @@ namespace coro
 auto wait_group::awaiter::await_suspend(std::coroutine_handle<> handle) noexcept -> bool
 {
     m_await_coro = handle;
+    m_prio       = detail::linfo.prio;
     m_ctx.register_wait();
     while (true)
     {
@@ -31,11 +33,6 @@ auto wait_group::awaiter::await_resume() noexcept -> void
     m_ctx.unregister_wait();
 }
 
-auto wait_group::awaiter::resume() noexcept -> void
-{
-    m_ctx.submit_task(m_await_coro);
-}
-
 auto wait_group::add(int count) noexcept -> void
 {
     m_count.fetch_add(count, std::memory_order_acq_rel);
@@ -46,11 +43,8 @@ auto wait_group::done() noexcept -> void
     if (m_count.fetch_sub(1,std::memory_order_acq_rel) == 1)
     {
         auto head = static_cast<awaiter*>(m_state.exchange(nullptr,std::memory_order_acq_rel));
-        while (head != nullptr)
-        {
-            head->resume();
-            head = head->m_next;
-        }
+        // 按context分组批量提交, 每个目标context只唤醒一次
+        detail::resume_grouped(head);
     }
 }
 
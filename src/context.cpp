@@ -1,29 +1,52 @@
 #include "coro/context.hpp"
 #include "coro/detail/container.hpp"
 #include "coro/meta_info.hpp"
+#include "coro/utils.hpp"
+#include <algorithm>
+#include <cassert>
+#include <array>
 #include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <limits>
 #include <optional>
 #include <stop_token>
 // #include "coro/sched"
 
 namespace coro 
 {
-context::context() noexcept
+context::context(const engine_options& opts) noexcept : m_engine(opts)
 {
     m_id = ginfo.context_id.fetch_add(1,std::memory_order_relaxed);
 }
 
+context::context(size_t index, const engine_options& opts) noexcept : context(opts)
+{
+    m_index = index;
+}
+
 auto context::start() noexcept -> void
 {
+    // 上一次运行结束时已经请求停止, 再次启动时使用新的停止信号
+    if (m_stop_source.stop_requested())
+    {
+        m_stop_source = stop_source{};
+    }
     m_job = make_unique<jthread>(
-        [this](stop_token token)
+        [this, token = m_stop_source.get_token()]()
         {
+            // 先绑定CPU再初始化engine, io_uring与任务队列的内存由绑定后的线程首次访问
+            if (m_cpu >= 0 && !utils::pin_thread_to_cpu(m_cpu))
+            {
+                // log::error("context pin cpu error");
+                std::exit(1);
+            }
             this->init();
             // 如果没有scheduler接管(没有设置 stop_cb)
-            // 则设置一个默认的停止回调: 调用 request_top()
+            // 则设置一个默认的停止回调: 请求停止并唤醒自身, 之后的poll_submit不会阻塞
             if (!(this->m_stop_cb))
             {
-                m_stop_cb = [&]() {m_job->request_stop();};
+                m_stop_cb = [&]() { this->notify_stop(); };
             }
             this->run(token);
             this->deinit();
@@ -32,7 +55,7 @@ auto context::start() noexcept -> void
 
 auto context::notify_stop() noexcept -> void
 {
-    m_job->request_stop();
+    m_stop_source.request_stop();
     m_engine.wake_up();
 }
 
@@ -69,8 +92,15 @@ auto context::run(stop_token token) noexcept -> void
             }
         }
 
-        // 执行IO协程任务
-        poll_work();
+        // 执行IO协程任务, 预算用尽时任务队列中仍有任务, 此时只收割已完成的IO而不阻塞
+        if (m_engine.ready())
+        {
+            m_engine.poll_ready();
+        }
+        else
+        {
+            poll_work();
+        }
     }
 }
 
@@ -82,11 +112,48 @@ auto context::process_work() noexcept -> void
     //     m_engine.exec_one_task();
     // }
 
-    auto num = m_engine.num_task_schedule();
-    for (int i = 0; i < num; i++)
+    // next slot可能由IO回调或上一轮剩余的任务填充
+    m_engine.exec_next_task();
+
+    // 按优先级从高到低执行本轮开始时各队列中的任务, 执行期间新提交的任务留到下一轮.
+    // 每个队列先保证prio_quota个任务, 剩余的预算优先分配给高优先级, 时间预算用尽后只执行保证的部分
+    const auto& opts = m_engine.get_options();
+
+    std::chrono::steady_clock::time_point deadline;
+    if (opts.task_time_budget_us > 0)
     {
-        m_engine.exec_one_task();
+        deadline = std::chrono::steady_clock::now() + std::chrono::microseconds(opts.task_time_budget_us);
+    }
+
+    std::array<size_t, engine::priority_num> nums;
+    for (size_t p = 0; p < engine::priority_num; p++)
+    {
+        nums[p] = m_engine.num_task_schedule(static_cast<task_priority>(p));
+    }
+
+    std::array<size_t, engine::priority_num> quotas;
+    size_t budget = opts.task_budget > 0 ? opts.task_budget : std::numeric_limits<size_t>::max();
+    for (size_t p = 0; p < engine::priority_num; p++)
+    {
+        quotas[p] = std::min(nums[p], opts.prio_quota);
+        budget -= std::min(quotas[p], budget);
+    }
 
+    bool expired = false;
+    for (size_t p = 0; p < engine::priority_num; p++)
+    {
+        auto extra = expired ? 0 : std::min(nums[p] - quotas[p], budget);
+        budget -= extra;
+        auto num = quotas[p] + extra;
+        for (size_t i = 0; i < num; i++)
+        {
+            m_engine.exec_one_task(static_cast<task_priority>(p));
+            if (!expired && opts.task_time_budget_us > 0 && std::chrono::steady_clock::now() >= deadline)
+            {
+                expired = true;
+                num     = std::max(i + 1, quotas[p]);
+            }
+        }
     }
 }
 
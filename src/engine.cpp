@@ -15,36 +15,86 @@ auto engine::init() noexcept -> void
     m_num_io_wait_submit = 0;
     m_num_io_running     = 0;
     m_max_recursive_depth = 0;
-    m_upxy.init(config::kEntryLength);
+    if (!m_opts.lazy_ring)
+    {
+        setup_ring();
+    }
+}
+
+auto engine::setup_ring() noexcept -> void
+{
+    // sqpoll下共享io-wq会连带共享SQPOLL内核线程, 除非显式要求, 否则各自独立创建
+    bool attach = m_opts.attach_wq && m_wq_anchor != nullptr && (!m_opts.sqpoll || m_opts.attach_wq_sqpoll);
+
+    int wq_fd = -1;
+    if (attach)
+    {
+        wq_fd = m_wq_anchor->load(std::memory_order_acquire);
+    }
+    m_upxy.init(m_opts.entry_length, m_opts.sqpoll, m_opts.sq_thread_idle, wq_fd);
+    if (attach && wq_fd < 0)
+    {
+        // 第一个创建的io_uring作为其他io_uring共享的对象
+        m_wq_anchor->compare_exchange_strong(wq_fd, m_upxy.ring_fd(), std::memory_order_acq_rel);
+    }
+    m_urc.resize(2 * m_opts.entry_length);
 }
 
 auto engine::deinit()  noexcept -> void
 {
+    if (m_wq_anchor != nullptr && m_upxy.ring_ready())
+    {
+        // 关闭后其他io_uring不能再共享该io_uring
+        int fd = m_upxy.ring_fd();
+        m_wq_anchor->compare_exchange_strong(fd, -1, std::memory_order_acq_rel);
+    }
     m_upxy.deinit();
     m_num_io_wait_submit = 0;
     m_num_io_running    = 0;
     m_max_recursive_depth = 0;
-    if (!m_task_queue.was_empty()) 
+    m_next_task           = nullptr;
+    m_next_prio           = task_priority::normal;
+    for (size_t i = 0; i < priority_num; i++)
     {
-        // log::warn("task queue isn't empty when engine deinit");
+        if (!m_task_queue[i].was_empty())
+        {
+            // log::warn("task queue isn't empty when engine deinit");
+        }
+        mpmc_queue<coroutine_handle<>> task_queue(queue_cap(m_opts, i));
+        m_task_queue[i].swap(task_queue);
     }
-    mpmc_queue<coroutine_handle<>> task_queue;
-    m_task_queue.swap(task_queue);
 }
 
 auto engine::schedule() noexcept -> coroutine_handle<>
 {
-    auto coro = m_task_queue.pop();
+    for (size_t i = 0; i + 1 < priority_num; i++)
+    {
+        if (!m_task_queue[i].was_empty())
+        {
+            return schedule(static_cast<task_priority>(i));
+        }
+    }
+    return schedule(static_cast<task_priority>(priority_num - 1));
+}
+
+auto engine::schedule(task_priority prio) noexcept -> coroutine_handle<>
+{
+    auto coro = m_task_queue[static_cast<size_t>(prio)].pop();
     assert(bool(coro));
     return coro;
 }
 
 
-auto engine::submit_task(coroutine_handle<> handle) noexcept -> void
+auto engine::submit_task(coroutine_handle<> handle, task_priority prio) noexcept -> void
 {
     assert(handle != nullptr && "engine get nullptr task handle");
-    if (m_task_queue.try_push(handle)) {
-        wake_up();
+    assert(prio < task_priority::none && "engine get invalid task priority");
+    if (m_task_queue[static_cast<size_t>(prio)].try_push(handle)) {
+        // 工作线程自己提交时不会阻塞在eventfd上, 不需要唤醒
+        if (linfo.egn != this)
+        {
+            wake_up();
+        }
     }
     else if (is_in_working_state())
     {
@@ -63,24 +113,102 @@ auto engine::submit_task(coroutine_handle<> handle) noexcept -> void
     }
 }
 
+auto engine::submit_batch(coroutine_handle<>* handles, size_t num, task_priority prio) noexcept -> void
+{
+    assert(prio < task_priority::none && "engine get invalid task priority");
+    size_t pushed = 0;
+    for (size_t i = 0; i < num; i++)
+    {
+        assert(handles[i] != nullptr && "engine get nullptr task handle");
+        if (m_task_queue[static_cast<size_t>(prio)].try_push(handles[i]))
+        {
+            ++pushed;
+        }
+        else
+        {
+            // 队列已满时退化为逐个提交, 由submit_task处理溢出
+            submit_task(handles[i], prio);
+        }
+    }
+    if (pushed > 0 && linfo.egn != this)
+    {
+        wake_up();
+    }
+}
+
+auto engine::submit_next(coroutine_handle<> handle, task_priority prio) noexcept -> void
+{
+    assert(handle != nullptr && "engine get nullptr task handle");
+    // 非工作线程上linfo.egn可能为空, 因此直接比较指针
+    if (m_opts.schedule == schedule_strategy::lifo && linfo.egn == this)
+    {
+        auto prev_prio = std::exchange(m_next_prio, prio);
+        if (auto prev = std::exchange(m_next_task, handle); prev != nullptr)
+        {
+            submit_task(prev, prev_prio);
+        }
+        return;
+    }
+    submit_task(handle, prio);
+}
+
+auto engine::exec_next_task() noexcept -> void
+{
+    for (size_t i = 0; m_next_task != nullptr; i++)
+    {
+        auto next = std::exchange(m_next_task, nullptr);
+        auto prio = m_next_prio;
+        if (i == config::kLifoSlotBudget)
+        {
+            submit_task(next, prio);
+            break;
+        }
+        // slot中的任务按其自身的优先级运行, 其发起的IO与yield回到对应的任务队列
+        linfo.prio = prio;
+        exec_task(next);
+        linfo.prio = task_priority::normal;
+    }
+}
+
 auto engine::exec_one_task() noexcept -> void
 {
-    auto coro = schedule();
+    // 与schedule()的选择顺序一致, 同时让linfo.prio反映任务所在队列的优先级
+    for (size_t i = 0; i + 1 < priority_num; i++)
+    {
+        if (!m_task_queue[i].was_empty())
+        {
+            exec_one_task(static_cast<task_priority>(i));
+            return;
+        }
+    }
+    exec_one_task(static_cast<task_priority>(priority_num - 1));
+}
+
+auto engine::exec_one_task(task_priority prio) noexcept -> void
+{
+    auto coro = schedule(prio);
+    linfo.prio = prio;
     exec_task(coro);
+    linfo.prio = task_priority::normal;
+    exec_next_task();
 }
 
 auto engine::exec_task(coroutine_handle<> handle) -> void
 {
+    // handle可能是嵌套的子协程, 结束后会被父协程销毁, resume之后不能再访问handle,
+    // 需要清理的顶层协程由final_suspend记录在linfo.finished中
+    linfo.finished = nullptr;
     handle.resume();
-    if (handle.done())
+    if (auto finished = std::exchange(linfo.finished, nullptr); finished != nullptr)
     {
-        clean(handle);
+        clean(finished);
     }
 }
 
 auto engine::handle_cqe_entry(urcptr cqe) noexcept -> void
 {
-    auto data = reinterpret_cast<io::detail::io_info*>(io_uring_cqe_get_data(cqe));
+    auto data   = reinterpret_cast<io::detail::io_info*>(io_uring_cqe_get_data(cqe));
+    data->flags = cqe->flags;
     data->cb(data, cqe->res);
 }
 
@@ -104,17 +232,40 @@ auto engine::poll_submit() noexcept -> void
         return;
     }
 
-    auto num = m_upxy.peek_batch_cqe(m_urc.data(), m_num_io_running);
-    
-    if (num != 0)
+    reap_cqe();
+}
+
+auto engine::poll_ready() noexcept -> void
+{
+    do_io_submit();
+    // 清空eventfd, 否则其他线程持续提交任务时计数会一直累积到上限
+    [[CORO_MAYBE_UNUSED]] auto _ = m_upxy.try_read_eventfd();
+    reap_cqe();
+}
+
+auto engine::reap_cqe() noexcept -> void
+{
+    if (!m_upxy.ring_ready())
+    {
+        return;
+    }
+
+    // multishot 请求的一次提交会产生多个CQE, 因此按m_urc容量而不是m_num_io_running批量获取,
+    // 取满时CQ中可能还有剩余的CQE, 它们对应的eventfd计数已经被读走, 需要继续收割
+    size_t num = 0;
+    do
     {
-        for (int i = 0; i < num; i++)
+        num = m_upxy.peek_batch_cqe(m_urc.data(), m_urc.size());
+        size_t num_finish = 0;
+        for (size_t i = 0; i < num; i++)
         {
+            // 携带IORING_CQE_F_MORE的CQE表示该请求仍在运行
+            num_finish += (m_urc[i]->flags & IORING_CQE_F_MORE) ? 0 : 1;
             handle_cqe_entry(m_urc[i]);
         }
         m_upxy.cq_advance(num);
-        m_num_io_running -= num;
-    }
+        m_num_io_running -= num_finish;
+    } while (num == m_urc.size());
 }
 
 auto engine::wake_up(uint64_t val) noexcept -> void
@@ -0,0 +1,47 @@
+#include "coro/io/buffer_ring.hpp"
+#include "coro/engine.hpp"
+
+namespace coro::io::detail
+{
+buffer_ring::buffer_ring(unsigned int buf_count, unsigned int buf_size) noexcept
+    : m_upxy(::coro::detail::local_engine().get_uring()),
+      m_bufs(new char[size_t(buf_count) * buf_size]),
+      m_buf_count(buf_count),
+      m_buf_size(buf_size)
+{
+    assert((buf_count & (buf_count - 1)) == 0 && "buffer ring size must be power of 2");
+
+    m_bgid = m_upxy.alloc_buf_group_id();
+
+    int ret = 0;
+    m_br    = m_upxy.setup_buf_ring(m_buf_count, m_bgid, &ret);
+    if (m_br == nullptr)
+    {
+        // log::error("uring_proxy setup buffer ring failed");
+        std::exit(1);
+    }
+
+    m_mask = io_uring_buf_ring_mask(m_buf_count);
+    for (unsigned int i = 0; i < m_buf_count; i++)
+    {
+        io_uring_buf_ring_add(m_br, get(i), m_buf_size, i, m_mask, i);
+    }
+    io_uring_buf_ring_advance(m_br, m_buf_count);
+}
+
+buffer_ring::~buffer_ring() noexcept
+{
+    if (m_br != nullptr)
+    {
+        m_upxy.free_buf_ring(m_br, m_buf_count, m_bgid);
+        m_br = nullptr;
+    }
+}
+
+auto buffer_ring::recycle(uint16_t bid) noexcept -> void
+{
+    io_uring_buf_ring_add(m_br, get(bid), m_buf_size, bid, m_mask, 0);
+    io_uring_buf_ring_advance(m_br, 1);
+}
+
+}; // namespace coro::io::detail
@@ -1,4 +1,5 @@
 #include <liburing.h>
+#include <netinet/udp.h>
 #include <optional>
 #include <unistd.h>
 
@@ -26,7 +27,7 @@ noop_awaiter::noop_awaiter() noexcept
 auto noop_awaiter::callback(io_info* data, int res) noexcept -> void
 {
     data->result = res;
-    submit_to_context(data->handle);
+    submit_to_context(data->handle, data->prio);
 }
 
 stdin_awaiter::stdin_awaiter(char* buf, size_t len, int io_flag, int sqe_flag) noexcept
@@ -43,7 +44,7 @@ stdin_awaiter::stdin_awaiter(char* buf, size_t len, int io_flag, int sqe_flag) n
 auto stdin_awaiter::callback(io_info* data, int res) noexcept -> void
 {
     data->result = res;
-    submit_to_context(data->handle);
+    submit_to_context(data->handle, data->prio);
 }
 
 namespace net
@@ -61,12 +62,13 @@ tcp_accept_awaiter::tcp_accept_awaiter(int listenfd, int io_flag, int sqe_flag)
     io_uring_sqe_set_flags(m_urs, sqe_flag);
     io_uring_prep_accept(m_urs, listenfd, nullptr, &len, io_flag);
     io_uring_sqe_set_data(m_urs, &m_info);
+    local_engine().add_io_submit();
 }
 
 auto tcp_accept_awaiter::callback(io_info* data, int res) noexcept -> void
 {
     data->result = res;
-    submit_to_context(data->handle);
+    submit_to_context(data->handle, data->prio);
 }
 
 tcp_read_awaiter::tcp_read_awaiter(int sockfd, char* buf, size_t len, int io_flag , int sqe_flag) noexcept
@@ -83,7 +85,7 @@ tcp_read_awaiter::tcp_read_awaiter(int sockfd, char* buf, size_t len, int io_fla
 auto tcp_read_awaiter::callback(io_info *data, int res) noexcept -> void
 {
     data->result = res;
-    submit_to_context(data->handle);
+    submit_to_context(data->handle, data->prio);
 }
 
 tcp_write_awaiter::tcp_write_awaiter(int sockfd, char* buf, size_t len, int io_flag, int sqe_flag) noexcept
@@ -100,7 +102,7 @@ tcp_write_awaiter::tcp_write_awaiter(int sockfd, char* buf, size_t len, int io_f
 auto tcp_write_awaiter::callback(io_info* data, int res) noexcept -> void
 {
     data->result = res;
-    submit_to_context(data->handle);
+    submit_to_context(data->handle, data->prio);
 }
 
 tcp_close_awaiter::tcp_close_awaiter(int sockfd) noexcept
@@ -116,7 +118,7 @@ tcp_close_awaiter::tcp_close_awaiter(int sockfd) noexcept
 auto tcp_close_awaiter::callback(io_info* data, int res) noexcept -> void
 {
     data->result = res;
-    submit_to_context(data->handle);
+    submit_to_context(data->handle, data->prio);
 }
 
 tcp_connect_awaiter::tcp_connect_awaiter(int sockfd, const sockaddr* addr, socklen_t addrlen) noexcept
@@ -140,9 +142,272 @@ auto tcp_connect_awaiter::callback(io_info* data, int res) noexcept -> void
     {
         data->result = static_cast<int>(data->data);
     }
-    submit_to_context(data->handle);
+    submit_to_context(data->handle, data->prio);
 }
 }; // namespace tcp
+
+/**
+* @brief udp awaiter
+*/
+namespace udp
+{
+udp_sendmsg_awaiter::udp_sendmsg_awaiter(
+    int sockfd, const char* buf, size_t len, const sockaddr* addr, socklen_t addrlen, uint16_t gso_size, int io_flag, int sqe_flag) noexcept
+{
+    m_info.type = io_type::udp_sendmsg;
+    m_info.cb   = &udp_sendmsg_awaiter::callback;
+
+    m_iov.iov_base = const_cast<char*>(buf);
+    m_iov.iov_len  = len;
+
+    memset(&m_msg, 0, sizeof(m_msg));
+    m_msg.msg_name    = const_cast<sockaddr*>(addr);
+    m_msg.msg_namelen = addrlen;
+    m_msg.msg_iov     = &m_iov;
+    m_msg.msg_iovlen  = 1;
+
+    if (gso_size > 0)
+    {
+        m_msg.msg_control    = m_control;
+        m_msg.msg_controllen = sizeof(m_control);
+
+        auto cmsg        = CMSG_FIRSTHDR(&m_msg);
+        cmsg->cmsg_level = SOL_UDP;
+        cmsg->cmsg_type  = UDP_SEGMENT;
+        cmsg->cmsg_len   = CMSG_LEN(sizeof(uint16_t));
+        memcpy(CMSG_DATA(cmsg), &gso_size, sizeof(gso_size));
+    }
+
+    io_uring_sqe_set_flags(m_urs, sqe_flag);
+    io_uring_prep_sendmsg(m_urs, sockfd, &m_msg, io_flag);
+    io_uring_sqe_set_data(m_urs, &m_info);
+    local_engine().add_io_submit();
+}
+
+auto udp_sendmsg_awaiter::callback(io_info* data, int res) noexcept -> void
+{
+    data->result = res;
+    submit_to_context(data->handle, data->prio);
+}
+
+udp_recvmsg_awaiter::udp_recvmsg_awaiter(
+    int sockfd, char* buf, size_t len, socket_address* src, int* gro_size, int io_flag, int sqe_flag) noexcept
+    : m_src(src),
+      m_gro_size(gro_size)
+{
+    m_info.type = io_type::udp_recvmsg;
+    m_info.cb   = &udp_recvmsg_awaiter::callback;
+    m_info.data = CASTPTR(this);
+
+    m_iov.iov_base = buf;
+    m_iov.iov_len  = len;
+
+    memset(&m_msg, 0, sizeof(m_msg));
+    m_msg.msg_name    = (src != nullptr) ? src->data() : nullptr;
+    m_msg.msg_namelen = (src != nullptr) ? socket_address::capacity() : 0;
+    m_msg.msg_iov     = &m_iov;
+    m_msg.msg_iovlen  = 1;
+    if (m_gro_size != nullptr)
+    {
+        m_msg.msg_control    = m_control;
+        m_msg.msg_controllen = sizeof(m_control);
+    }
+
+    io_uring_sqe_set_flags(m_urs, sqe_flag);
+    io_uring_prep_recvmsg(m_urs, sockfd, &m_msg, io_flag);
+    io_uring_sqe_set_data(m_urs, &m_info);
+    local_engine().add_io_submit();
+}
+
+auto udp_recvmsg_awaiter::callback(io_info* data, int res) noexcept -> void
+{
+    auto self = reinterpret_cast<udp_recvmsg_awaiter*>(data->data);
+    if (self->m_src != nullptr && res >= 0)
+    {
+        self->m_src->set_size(self->m_msg.msg_namelen);
+    }
+    if (self->m_gro_size != nullptr)
+    {
+        *(self->m_gro_size) = 0;
+        for (auto cmsg = CMSG_FIRSTHDR(&self->m_msg); res >= 0 && cmsg != nullptr;
+             cmsg      = CMSG_NXTHDR(&self->m_msg, cmsg))
+        {
+            if (cmsg->cmsg_level == SOL_UDP && cmsg->cmsg_type == UDP_GRO)
+            {
+                memcpy(self->m_gro_size, CMSG_DATA(cmsg), sizeof(int));
+                break;
+            }
+        }
+    }
+
+    data->result = res;
+    submit_to_context(data->handle, data->prio);
+}
+
+udp_close_awaiter::udp_close_awaiter(int sockfd) noexcept
+{
+    m_info.type = io_type::udp_close;
+    m_info.cb   = &udp_close_awaiter::callback;
+
+    io_uring_prep_close(m_urs, sockfd);
+    io_uring_sqe_set_data(m_urs, &m_info);
+    local_engine().add_io_submit();
+}
+
+auto udp_close_awaiter::callback(io_info* data, int res) noexcept -> void
+{
+    data->result = res;
+    submit_to_context(data->handle, data->prio);
+}
+}; // namespace udp
+
+/**
+* @brief unix domain socket awaiter
+*/
+namespace uds
+{
+uds_sendmsg_awaiter::uds_sendmsg_awaiter(
+    int                   sockfd,
+    const char*           buf,
+    size_t                len,
+    const socket_address* dst,
+    const int*            fds,
+    size_t                nfds,
+    int                   io_flag,
+    int                   sqe_flag) noexcept
+{
+    m_info.type = io_type::uds_sendmsg;
+    m_info.cb   = &uds_sendmsg_awaiter::callback;
+
+    // 描述符数量超出m_control的容量, 提交nop并以-EINVAL完成, 不构造控制消息
+    if (fds != nullptr && nfds > ::coro::config::kUdsMaxFds)
+    {
+        m_info.cb = &uds_sendmsg_awaiter::reject_callback;
+        io_uring_sqe_set_flags(m_urs, sqe_flag);
+        io_uring_prep_nop(m_urs);
+        io_uring_sqe_set_data(m_urs, &m_info);
+        local_engine().add_io_submit();
+        return;
+    }
+
+    m_iov.iov_base = const_cast<char*>(buf);
+    m_iov.iov_len  = len;
+
+    memset(&m_msg, 0, sizeof(m_msg));
+    m_msg.msg_name    = (dst != nullptr) ? const_cast<sockaddr*>(dst->data()) : nullptr;
+    m_msg.msg_namelen = (dst != nullptr) ? dst->size() : 0;
+    m_msg.msg_iov     = &m_iov;
+    m_msg.msg_iovlen  = 1;
+
+    if (fds != nullptr && nfds > 0)
+    {
+        m_msg.msg_control    = m_control;
+        m_msg.msg_controllen = CMSG_SPACE(sizeof(int) * nfds);
+
+        auto cmsg        = CMSG_FIRSTHDR(&m_msg);
+        cmsg->cmsg_level = SOL_SOCKET;
+        cmsg->cmsg_type  = SCM_RIGHTS;
+        cmsg->cmsg_len   = CMSG_LEN(sizeof(int) * nfds);
+        memcpy(CMSG_DATA(cmsg), fds, sizeof(int) * nfds);
+    }
+
+    io_uring_sqe_set_flags(m_urs, sqe_flag);
+    io_uring_prep_sendmsg(m_urs, sockfd, &m_msg, io_flag);
+    io_uring_sqe_set_data(m_urs, &m_info);
+    local_engine().add_io_submit();
+}
+
+auto uds_sendmsg_awaiter::callback(io_info* data, int res) noexcept -> void
+{
+    data->result = res;
+    submit_to_context(data->handle, data->prio);
+}
+
+auto uds_sendmsg_awaiter::reject_callback(io_info* data, [[CORO_MAYBE_UNUSED]] int res) noexcept -> void
+{
+    data->result = -EINVAL;
+    submit_to_context(data->handle, data->prio);
+}
+
+uds_recvmsg_awaiter::uds_recvmsg_awaiter(
+    int             sockfd,
+    char*           buf,
+    size_t          len,
+    socket_address* src,
+    int*            fds,
+    size_t          max_fds,
+    size_t*         nfds,
+    int             io_flag,
+    int             sqe_flag) noexcept
+    : m_src(src),
+      m_fds(fds),
+      m_max_fds(fds != nullptr ? max_fds : 0),
+      m_nfds(nfds)
+{
+    m_info.type = io_type::uds_recvmsg;
+    m_info.cb   = &uds_recvmsg_awaiter::callback;
+    m_info.data = CASTPTR(this);
+
+    m_iov.iov_base = buf;
+    m_iov.iov_len  = len;
+
+    memset(&m_msg, 0, sizeof(m_msg));
+    m_msg.msg_name       = (src != nullptr) ? src->data() : nullptr;
+    m_msg.msg_namelen    = (src != nullptr) ? socket_address::capacity() : 0;
+    m_msg.msg_iov        = &m_iov;
+    m_msg.msg_iovlen     = 1;
+    m_msg.msg_control    = m_control;
+    m_msg.msg_controllen = sizeof(m_control);
+
+    io_uring_sqe_set_flags(m_urs, sqe_flag);
+    // 收到的描述符默认设置close-on-exec
+    io_uring_prep_recvmsg(m_urs, sockfd, &m_msg, io_flag | MSG_CMSG_CLOEXEC);
+    io_uring_sqe_set_data(m_urs, &m_info);
+    local_engine().add_io_submit();
+}
+
+auto uds_recvmsg_awaiter::callback(io_info* data, int res) noexcept -> void
+{
+    auto self = reinterpret_cast<uds_recvmsg_awaiter*>(data->data);
+    if (self->m_src != nullptr && res >= 0)
+    {
+        self->m_src->set_size(self->m_msg.msg_namelen);
+    }
+
+    size_t cnt = 0;
+    for (auto cmsg = CMSG_FIRSTHDR(&self->m_msg); res >= 0 && cmsg != nullptr;
+         cmsg      = CMSG_NXTHDR(&self->m_msg, cmsg))
+    {
+        if (cmsg->cmsg_level != SOL_SOCKET || cmsg->cmsg_type != SCM_RIGHTS)
+        {
+            continue;
+        }
+
+        auto num = (cmsg->cmsg_len - CMSG_LEN(0)) / sizeof(int);
+        for (size_t i = 0; i < num; i++)
+        {
+            int fd;
+            memcpy(&fd, CMSG_DATA(cmsg) + i * sizeof(int), sizeof(int));
+            if (cnt < self->m_max_fds)
+            {
+                self->m_fds[cnt++] = fd;
+            }
+            else
+            {
+                // 调用者无法接收的描述符必须关闭, 否则会泄漏
+                ::close(fd);
+            }
+        }
+    }
+    if (self->m_nfds != nullptr)
+    {
+        *(self->m_nfds) = cnt;
+    }
+
+    data->result = res;
+    submit_to_context(data->handle, data->prio);
+}
+}; // namespace uds
 }; // namespace net 
     
 
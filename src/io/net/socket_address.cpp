@@ -0,0 +1,122 @@
+#include <arpa/inet.h>
+#include <cstddef>
+#include <cstring>
+#include <netinet/in.h>
+#include <sys/un.h>
+
+#include "coro/io/net/socket_address.hpp"
+
+namespace coro::io::net
+{
+auto socket_address::ipv4(const char* addr, int port) noexcept -> socket_address
+{
+    socket_address sa;
+    auto           sin = reinterpret_cast<sockaddr_in*>(&sa.m_addr);
+    if (addr == nullptr || inet_pton(AF_INET, addr, &sin->sin_addr) != 1)
+    {
+        return socket_address{};
+    }
+    sin->sin_family = AF_INET;
+    sin->sin_port   = htons(port);
+    sa.m_len        = sizeof(sockaddr_in);
+    return sa;
+}
+
+auto socket_address::ipv6(const char* addr, int port) noexcept -> socket_address
+{
+    socket_address sa;
+    auto           sin6 = reinterpret_cast<sockaddr_in6*>(&sa.m_addr);
+    if (addr == nullptr || inet_pton(AF_INET6, addr, &sin6->sin6_addr) != 1)
+    {
+        return socket_address{};
+    }
+    sin6->sin6_family = AF_INET6;
+    sin6->sin6_port   = htons(port);
+    sa.m_len          = sizeof(sockaddr_in6);
+    return sa;
+}
+
+auto socket_address::parse(const char* addr, int port) noexcept -> socket_address
+{
+    if (addr == nullptr)
+    {
+        return any(port);
+    }
+    // ipv4的点分十进制中不会出现':'
+    return strchr(addr, ':') != nullptr ? ipv6(addr, port) : ipv4(addr, port);
+}
+
+auto socket_address::any(int port) noexcept -> socket_address
+{
+    socket_address sa;
+    auto           sin6 = reinterpret_cast<sockaddr_in6*>(&sa.m_addr);
+    sin6->sin6_family   = AF_INET6;
+    sin6->sin6_port     = htons(port);
+    sin6->sin6_addr     = in6addr_any;
+    sa.m_len            = sizeof(sockaddr_in6);
+    return sa;
+}
+
+auto socket_address::any_ipv4(int port) noexcept -> socket_address
+{
+    socket_address sa;
+    auto           sin   = reinterpret_cast<sockaddr_in*>(&sa.m_addr);
+    sin->sin_family      = AF_INET;
+    sin->sin_port        = htons(port);
+    sin->sin_addr.s_addr = htonl(INADDR_ANY);
+    sa.m_len             = sizeof(sockaddr_in);
+    return sa;
+}
+
+auto socket_address::unix_path(const char* path) noexcept -> socket_address
+{
+    socket_address sa;
+    auto           sun = reinterpret_cast<sockaddr_un*>(&sa.m_addr);
+
+    auto len = path == nullptr ? 0 : strlen(path);
+    if (len == 0 || len >= sizeof(sun->sun_path))
+    {
+        return socket_address{};
+    }
+
+    sun->sun_family = AF_UNIX;
+    memcpy(sun->sun_path, path, len);
+    if (path[0] == '@')
+    {
+        // abstract namespace, 地址长度不包含结尾的'\0'
+        sun->sun_path[0] = '\0';
+        sa.m_len         = offsetof(sockaddr_un, sun_path) + len;
+    }
+    else
+    {
+        sa.m_len = offsetof(sockaddr_un, sun_path) + len + 1;
+    }
+    return sa;
+}
+
+auto socket_address::port() const noexcept -> int
+{
+    switch (m_addr.ss_family)
+    {
+        case AF_INET:
+            return ntohs(reinterpret_cast<const sockaddr_in*>(&m_addr)->sin_port);
+        case AF_INET6:
+            return ntohs(reinterpret_cast<const sockaddr_in6*>(&m_addr)->sin6_port);
+        default:
+            return 0;
+    }
+}
+
+auto socket_address::is_any() const noexcept -> bool
+{
+    switch (m_addr.ss_family)
+    {
+        case AF_INET:
+            return reinterpret_cast<const sockaddr_in*>(&m_addr)->sin_addr.s_addr == htonl(INADDR_ANY);
+        case AF_INET6:
+            return IN6_IS_ADDR_UNSPECIFIED(&reinterpret_cast<const sockaddr_in6*>(&m_addr)->sin6_addr);
+        default:
+            return false;
+    }
+}
+}; // namespace coro::io::net
@@ -11,42 +11,61 @@
 
 namespace coro::io::net::tcp
 {
-tcp_server::tcp_server(const char* addr,int port) noexcept
+tcp_server::tcp_server(const char* addr, int port, int backlog, bool reuse_port) noexcept
+    : tcp_server(socket_address::parse(addr, port), backlog, reuse_port)
 {
-    m_listenfd = socket(AF_INET, SOCK_STREAM, 0);
+}
+
+tcp_server::tcp_server(const socket_address& addr, int backlog, bool reuse_port) noexcept : m_serveraddr(addr)
+{
+    if (!m_serveraddr.valid())
+    {
+        // log::error("addr invalid");
+        std::exit(1);
+    }
+
+    m_listenfd = socket(m_serveraddr.family(), SOCK_STREAM, 0);
+    if (m_listenfd < 0 && m_serveraddr.is_ipv6() && m_serveraddr.is_any())
+    {
+        // 内核未开启ipv6时退化为ipv4通配地址
+        m_serveraddr = socket_address::any_ipv4(m_serveraddr.port());
+        m_listenfd   = socket(AF_INET, SOCK_STREAM, 0);
+    }
     assert(m_listenfd != -1);
 
     coro::utils::set_fd_noblock(m_listenfd);
 
-    memset(&m_serveraddr,0,sizeof(m_serveraddr));
-    m_serveraddr.sin_family = AF_INET;
-    m_serveraddr.sin_port   = htons(port);
-    if (addr != nullptr)
+    if (m_serveraddr.is_ipv6() && m_serveraddr.is_any())
+    {
+        // 双栈监听, ipv4连接以v4-mapped地址的形式到达
+        int off = 0;
+        setsockopt(m_listenfd, IPPROTO_IPV6, IPV6_V6ONLY, &off, sizeof(off));
+    }
+
+    if (reuse_port)
     {
-        if (inet_pton(AF_INET, addr, &m_serveraddr.sin_addr.s_addr) < 0)
+        int on = 1;
+        if (setsockopt(m_listenfd, SOL_SOCKET, SO_REUSEPORT, &on, sizeof(on)) != 0)
         {
-            // log::error("addr invalid");
+            // log::error("server set SO_REUSEPORT error");
             std::exit(1);
         }
     }
-    else
-    {
-        m_serveraddr.sin_addr.s_addr    = htonl(INADDR_ANY);
-    }
 
-    if (bind(m_listenfd,(sockaddr*)&m_serveraddr,sizeof(m_serveraddr)) != 0)
+    if (bind(m_listenfd, m_serveraddr.data(), m_serveraddr.size()) != 0)
     {
         // log::error("server bind error");
         std::exit(1);
     }
 
-    if (listen(m_listenfd, ::coro::config::kBacklog) != 0)
+    if (listen(m_listenfd, backlog) != 0)
     {
         // log::error("server listen error");
         std::exit(1);
     }
 
-    m_sqe_flag = 0;
+    m_original_fd = m_listenfd;
+    m_sqe_flag    = 0;
     m_fixed_fd.assign(m_listenfd, m_sqe_flag);
 }
 
@@ -56,35 +75,37 @@ tcp_accept_awaiter tcp_server::accept(int io_flags) noexcept
 }
 
 tcp_client::tcp_client(const char* addr, int port) noexcept
+    : tcp_client(addr == nullptr ? socket_address::any_ipv4(port) : socket_address::parse(addr, port))
 {
-    m_clientfd = socket(AF_INET,SOCK_STREAM,0);
-    if (m_clientfd < 0)
+}
+
+tcp_client::tcp_client(const socket_address& addr) noexcept : m_serveraddr(addr)
+{
+    if (!m_serveraddr.valid())
     {
-        // log::error("clientfd init error");
+        // log::error("address error");
         std::exit(1);
     }
 
-    utils::set_fd_noblock(m_clientfd);
-
-    memset(&m_serveraddr,0,sizeof(m_serveraddr));
-    m_serveraddr.sin_family = AF_INET;
-    m_serveraddr.sin_port   = htons(port);
-    if (addr != nullptr)
+    m_clientfd = socket(m_serveraddr.family(), SOCK_STREAM, 0);
+    if (m_clientfd < 0 && m_serveraddr.is_ipv6() && m_serveraddr.is_any())
     {
-        if (inet_pton(AF_INET, addr, &m_serveraddr.sin_addr.s_addr) < 0)
-        {
-            // log::error("address error");
-            std::exit(1);
-        }
+        // 内核未开启ipv6时退化为ipv4通配地址, 与tcp_server一致
+        m_serveraddr = socket_address::any_ipv4(m_serveraddr.port());
+        m_clientfd   = socket(AF_INET, SOCK_STREAM, 0);
     }
-    else
+    if (m_clientfd < 0)
     {
-        m_serveraddr.sin_addr.s_addr = htonl(INADDR_ANY);
+        // log::error("clientfd init error");
+        std::exit(1);
     }
+
+    utils::set_fd_noblock(m_clientfd);
 }
 
 tcp_connect_awaiter tcp_client::connect() noexcept
 {
-    return tcp_connect_awaiter(m_clientfd,(sockaddr*)&m_serveraddr,sizeof(m_serveraddr));
+    // 直接引用内联存储的地址, 不需要拷贝
+    return tcp_connect_awaiter(m_clientfd, m_serveraddr.data(), m_serveraddr.size());
 }
 };
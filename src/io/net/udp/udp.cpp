@@ -0,0 +1,232 @@
+#include <algorithm>
+#include <arpa/inet.h>
+#include <cstdlib>
+#include <cstring>
+#include <netinet/in.h>
+#include <netinet/udp.h>
+#include <sys/socket.h>
+#include <utility>
+
+#include "coro/io/net/udp/udp.hpp"
+#include "coro/context.hpp"
+#include "coro/engine.hpp"
+#include "coro/io/io_info.hpp"
+#include "coro/utils.hpp"
+
+namespace coro::io::net::udp
+{
+using ::coro::detail::local_engine;
+using ::coro::io::detail::io_type;
+
+udp_socket::udp_socket(int family) noexcept
+{
+    m_sockfd = socket(family, SOCK_DGRAM, 0);
+    if (m_sockfd < 0)
+    {
+        // log::error("udp socket init error");
+        std::exit(1);
+    }
+
+    utils::set_fd_noblock(m_sockfd);
+}
+
+udp_socket::udp_socket(const char* addr, int port) noexcept : udp_socket(socket_address::parse(addr, port)) {}
+
+udp_socket::udp_socket(const socket_address& addr) noexcept
+{
+    if (!addr.valid())
+    {
+        // log::error("addr invalid");
+        std::exit(1);
+    }
+
+    auto localaddr = addr;
+    m_sockfd       = socket(localaddr.family(), SOCK_DGRAM, 0);
+    if (m_sockfd < 0 && localaddr.is_ipv6() && localaddr.is_any())
+    {
+        // 内核未开启ipv6时退化为ipv4通配地址
+        localaddr = socket_address::any_ipv4(localaddr.port());
+        m_sockfd  = socket(AF_INET, SOCK_DGRAM, 0);
+    }
+    if (m_sockfd < 0)
+    {
+        // log::error("udp socket init error");
+        std::exit(1);
+    }
+
+    utils::set_fd_noblock(m_sockfd);
+
+    if (localaddr.is_ipv6() && localaddr.is_any())
+    {
+        int off = 0;
+        setsockopt(m_sockfd, IPPROTO_IPV6, IPV6_V6ONLY, &off, sizeof(off));
+    }
+
+    if (bind(m_sockfd, localaddr.data(), localaddr.size()) != 0)
+    {
+        // log::error("udp bind error");
+        std::exit(1);
+    }
+}
+
+auto udp_socket::enable_gro() noexcept -> bool
+{
+    int on = 1;
+    return setsockopt(m_sockfd, SOL_UDP, UDP_GRO, &on, sizeof(on)) == 0;
+}
+
+udp_receiver::udp_receiver(udp_socket& sock, unsigned int buf_count, unsigned int buf_size) noexcept
+    : m_sockfd(sock.fd()),
+      m_ring(buf_count, buf_size),
+      m_done(buf_count + 1) // 每个携带数据的CQE占用一个buffer, 另外最多有一个终止CQE
+{
+    memset(&m_msg, 0, sizeof(m_msg));
+    m_msg.msg_namelen    = sizeof(sockaddr_in6); // 足够容纳ipv4与ipv6地址
+    m_msg.msg_controllen = CMSG_SPACE(sizeof(int)); // UDP_GRO
+
+    m_info.type = io_type::udp_recv_multishot;
+    m_info.cb   = &udp_receiver::callback;
+    m_info.data = CASTPTR(this);
+
+    m_cancel_info.type = io_type::async_cancel;
+    m_cancel_info.cb   = &udp_receiver::cancel_callback;
+    m_cancel_info.data = CASTPTR(this);
+}
+
+udp_receiver::~udp_receiver() noexcept
+{
+    assert(!m_armed && "udp_receiver destroyed while multishot recvmsg is running, co_await stop() first");
+}
+
+auto udp_receiver::recv_awaiter::await_suspend(std::coroutine_handle<> handle) noexcept -> void
+{
+    m_rx.m_waiter = handle;
+    if (!m_rx.m_armed)
+    {
+        m_rx.arm();
+    }
+}
+
+auto udp_receiver::stop_awaiter::await_suspend(std::coroutine_handle<> handle) noexcept -> void
+{
+    m_rx.m_stop_waiter  = handle;
+    m_rx.m_stop_pending = 2; // cancel请求本身与multishot请求各产生一个CQE
+
+    auto& engine = local_engine();
+    auto  sqe    = engine.get_free_urs();
+    while (sqe == nullptr)
+    {
+        engine.get_uring().submit();
+        sqe = engine.get_free_urs();
+    }
+    io_uring_prep_cancel64(sqe, CASTPTR(&m_rx.m_info), 0);
+    io_uring_sqe_set_data(sqe, &m_rx.m_cancel_info);
+    engine.add_io_submit();
+}
+
+auto udp_receiver::arm() noexcept -> void
+{
+    auto& engine = local_engine();
+    auto  sqe    = engine.get_free_urs();
+    while (sqe == nullptr)
+    {
+        engine.get_uring().submit();
+        sqe = engine.get_free_urs();
+    }
+
+    io_uring_prep_recvmsg_multishot(sqe, m_sockfd, &m_msg, 0);
+    io_uring_sqe_set_flags(sqe, IOSQE_BUFFER_SELECT);
+    sqe->buf_group = m_ring.group_id();
+    io_uring_sqe_set_data(sqe, &m_info);
+    engine.add_io_submit();
+
+    m_armed = true;
+}
+
+auto udp_receiver::pop_datagram() noexcept -> udp_datagram
+{
+    assert(m_num_done > 0);
+    auto cqe    = m_done[m_done_head];
+    m_done_head = (m_done_head + 1) % m_done.size();
+    --m_num_done;
+
+    udp_datagram dg;
+    if (!(cqe.flags & IORING_CQE_F_BUFFER))
+    {
+        // 错误或者终止, 未占用buffer
+        dg.len = cqe.res < 0 ? cqe.res : -ENOBUFS;
+        return dg;
+    }
+
+    dg.bid   = static_cast<int32_t>(cqe.flags >> IORING_CQE_BUFFER_SHIFT);
+    auto buf = m_ring.get(static_cast<uint16_t>(dg.bid));
+    auto out = io_uring_recvmsg_validate(buf, cqe.res, &m_msg);
+    if (out == nullptr)
+    {
+        dg.len = -EINVAL;
+        return dg;
+    }
+
+    auto namelen = std::min<socklen_t>(out->namelen, m_msg.msg_namelen);
+    memcpy(dg.src.data(), io_uring_recvmsg_name(out), namelen);
+    dg.src.set_size(namelen);
+    dg.data = static_cast<const char*>(io_uring_recvmsg_payload(out, &m_msg));
+    dg.len  = static_cast<int>(io_uring_recvmsg_payload_length(out, cqe.res, &m_msg));
+
+    for (auto cmsg = io_uring_recvmsg_cmsg_firsthdr(out, &m_msg); cmsg != nullptr;
+         cmsg      = io_uring_recvmsg_cmsg_nexthdr(out, &m_msg, cmsg))
+    {
+        if (cmsg->cmsg_level == SOL_UDP && cmsg->cmsg_type == UDP_GRO)
+        {
+            memcpy(&dg.segment_size, CMSG_DATA(cmsg), sizeof(int));
+            break;
+        }
+    }
+    return dg;
+}
+
+auto udp_receiver::recycle(const udp_datagram& dg) noexcept -> void
+{
+    if (dg.bid >= 0)
+    {
+        m_ring.recycle(static_cast<uint16_t>(dg.bid));
+    }
+}
+
+auto udp_receiver::callback(io_info* data, int res) noexcept -> void
+{
+    auto self = reinterpret_cast<udp_receiver*>(data->data);
+
+    auto tail          = (self->m_done_head + self->m_num_done) % self->m_done.size();
+    self->m_done[tail] = completion{.res = res, .flags = data->flags};
+    ++self->m_num_done;
+
+    if (!(data->flags & IORING_CQE_F_MORE))
+    {
+        self->m_armed = false;
+        if (self->m_stop_waiter != nullptr)
+        {
+            self->finish_stop();
+        }
+    }
+
+    if (self->m_waiter != nullptr)
+    {
+        submit_to_context(std::exchange(self->m_waiter, nullptr));
+    }
+}
+
+auto udp_receiver::cancel_callback(io_info* data, [[CORO_MAYBE_UNUSED]] int res) noexcept -> void
+{
+    reinterpret_cast<udp_receiver*>(data->data)->finish_stop();
+}
+
+auto udp_receiver::finish_stop() noexcept -> void
+{
+    if (--m_stop_pending == 0)
+    {
+        submit_to_context(std::exchange(m_stop_waiter, nullptr));
+    }
+}
+
+}; // namespace coro::io::net::udp
@@ -0,0 +1,145 @@
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "coro/io/net/uds/uds.hpp"
+// #include "coro/log.hpp"
+#include "coro/io/io_awaiter.hpp"
+#include "coro/io/io_info.hpp"
+#include "coro/utils.hpp"
+
+namespace coro::io::net::uds
+{
+namespace
+{
+// 绑定前删除文件系统中残留的同名socket文件, abstract namespace不需要.
+// 只有路径是socket文件且connect返回ECONNREFUSED(没有进程在监听)时才删除
+auto unlink_stale(const socket_address& addr, int type) noexcept -> void
+{
+    auto path = reinterpret_cast<const sockaddr_un*>(addr.data())->sun_path;
+    if (path[0] == '\0')
+    {
+        return;
+    }
+
+    struct stat st;
+    if (::lstat(path, &st) != 0 || !S_ISSOCK(st.st_mode))
+    {
+        return;
+    }
+
+    int probe = socket(AF_UNIX, type, 0);
+    if (probe < 0)
+    {
+        return;
+    }
+    bool stale = ::connect(probe, addr.data(), addr.size()) != 0 && errno == ECONNREFUSED;
+    ::close(probe);
+
+    if (stale)
+    {
+        ::unlink(path);
+    }
+}
+}; // namespace
+
+uds_server::uds_server(const socket_address& addr) noexcept : m_serveraddr(addr)
+{
+    if (!m_serveraddr.is_unix())
+    {
+        // log::error("uds path invalid");
+        std::exit(1);
+    }
+
+    m_listenfd = socket(AF_UNIX, SOCK_STREAM, 0);
+    assert(m_listenfd != -1);
+
+    coro::utils::set_fd_noblock(m_listenfd);
+
+    unlink_stale(m_serveraddr, SOCK_STREAM);
+    if (bind(m_listenfd, m_serveraddr.data(), m_serveraddr.size()) != 0)
+    {
+        // log::error("uds server bind error");
+        std::exit(1);
+    }
+
+    if (listen(m_listenfd, ::coro::config::kBacklog) != 0)
+    {
+        // log::error("uds server listen error");
+        std::exit(1);
+    }
+
+    m_sqe_flag = 0;
+    m_fixed_fd.assign(m_listenfd, m_sqe_flag);
+}
+
+uds_accept_awaiter uds_server::accept(int io_flags) noexcept
+{
+    return uds_accept_awaiter(m_listenfd, io_flags, m_sqe_flag);
+}
+
+uds_client::uds_client(const socket_address& addr) noexcept : m_serveraddr(addr)
+{
+    if (!m_serveraddr.is_unix())
+    {
+        // log::error("uds path invalid");
+        std::exit(1);
+    }
+
+    m_clientfd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (m_clientfd < 0)
+    {
+        // log::error("uds clientfd init error");
+        std::exit(1);
+    }
+
+    utils::set_fd_noblock(m_clientfd);
+}
+
+uds_connect_awaiter uds_client::connect() noexcept
+{
+    return uds_connect_awaiter(m_clientfd, m_serveraddr.data(), m_serveraddr.size());
+}
+
+uds_datagram::uds_datagram(const char* path) noexcept
+{
+    m_sockfd = socket(AF_UNIX, SOCK_DGRAM, 0);
+    if (m_sockfd < 0)
+    {
+        // log::error("uds datagram init error");
+        std::exit(1);
+    }
+
+    utils::set_fd_noblock(m_sockfd);
+
+    if (path != nullptr)
+    {
+        bind_local(socket_address::unix_path(path));
+    }
+}
+
+uds_datagram::uds_datagram(const socket_address& addr) noexcept : uds_datagram(nullptr)
+{
+    bind_local(addr);
+}
+
+auto uds_datagram::bind_local(const socket_address& addr) noexcept -> void
+{
+    if (!addr.is_unix())
+    {
+        // log::error("uds path invalid");
+        std::exit(1);
+    }
+
+    unlink_stale(addr, SOCK_DGRAM);
+    if (bind(m_sockfd, addr.data(), addr.size()) != 0)
+    {
+        // log::error("uds datagram bind error");
+        std::exit(1);
+    }
+}
+}; // namespace coro::io::net::uds
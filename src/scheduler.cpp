@@ -1,20 +1,112 @@
+#include <algorithm>
+#include <memory>
+#include <thread>
+#include <vector>
+
 #include "coro/scheduler.hpp"
 #include "coro/meta_info.hpp"
+#include "coro/utils.hpp"
 
 namespace coro
 {
-auto scheduler::init_impl(size_t ctx_cnt) noexcept -> void
+namespace
+{
+/**
+ * @brief 在绑定到cpu的临时线程上构造context, 使engine的任务队列等内存由cpu所在的NUMA节点首次访问
+ *
+ * 逐个构造并等待线程结束, 保证context下标与构造顺序一致. 绑定失败时(如cpu不在进程允许的集合中)
+ * context不绑定cpu, 也不记录NUMA节点, 与未开启pin_cpu时相同
+ */
+auto make_context_on(int cpu, size_t index, const engine_options& opts) noexcept -> std::unique_ptr<context>
+{
+    std::unique_ptr<context> ctx;
+    bool                     pinned = false;
+    std::thread(
+        [&ctx, &opts, &pinned, cpu, index]()
+        {
+            pinned = utils::pin_thread_to_cpu(cpu);
+            ctx    = std::make_unique<context>(index, opts);
+        })
+        .join();
+    if (pinned)
+    {
+        ctx->set_cpu(cpu);
+        ctx->set_node(utils::get_numa_node(cpu));
+    }
+    return ctx;
+}
+
+/**
+ * @brief 按NUMA节点交错排列cpu: 依次从每个节点取一个cpu, 节点内保持从小到大的顺序
+ *
+ * context按该顺序轮流绑定cpu, 数量少于cpu时各节点分到的context数最多相差一个,
+ * 而不是先占满编号较小的节点
+ */
+auto interleave_by_node(const std::vector<int>& cpus) noexcept -> std::vector<int>
+{
+    std::vector<int>              nodes;
+    std::vector<std::vector<int>> groups;
+    for (auto cpu : cpus)
+    {
+        auto node = utils::get_numa_node(cpu);
+        auto it   = std::find(nodes.begin(), nodes.end(), node);
+        if (it == nodes.end())
+        {
+            nodes.push_back(node);
+            groups.emplace_back();
+            it = nodes.end() - 1;
+        }
+        groups[it - nodes.begin()].push_back(cpu);
+    }
+
+    std::vector<int> order;
+    order.reserve(cpus.size());
+    for (size_t i = 0; order.size() < cpus.size(); i++)
+    {
+        for (auto& group : groups)
+        {
+            if (i < group.size())
+            {
+                order.push_back(group[i]);
+            }
+        }
+    }
+    return order;
+}
+}; // namespace
+
+auto scheduler::init_impl(const scheduler_options& opts) noexcept -> void
 {
-    detail::init_meta_info();
+    m_opts = opts;
+    if (m_opts.ctx_cnt == 0)
+    {
+        m_opts.ctx_cnt = std::thread::hardware_concurrency();
+    }
 
-    m_ctx_cnt = ctx_cnt;
+    // context下标只在本scheduler中有意义, 用于路由; context id在所有scheduler之间全局唯一
+    m_ctx_cnt = m_opts.ctx_cnt;
     m_ctxs    = detail::ctx_container{};
     m_ctxs.reserve(m_ctx_cnt);
+    m_wq_fd = -1;
+    std::vector<int> cpus;
+    if (m_opts.pin_cpu)
+    {
+        cpus = interleave_by_node(utils::get_allowed_cpus());
+    }
     for (int i = 0; i < m_ctx_cnt; i++)
     {
-        m_ctxs.emplace_back(std::make_unique<context>());
+        if (cpus.empty())
+        {
+            m_ctxs.emplace_back(std::make_unique<context>(i, m_opts.engine_opts));
+        }
+        else
+        {
+            m_ctxs.emplace_back(make_context_on(cpus[i % cpus.size()], i, m_opts.engine_opts));
+        }
+        m_ctxs.back()->set_scheduler(this);
+        m_ctxs.back()->get_engine().set_wq_anchor(&m_wq_fd);
     }
-    m_dispatcher.init(m_ctx_cnt,&m_ctxs);
+    m_dispatcher.init(m_ctx_cnt, &m_ctxs, this);
     m_ctx_stop_flag = stop_flag_type(m_ctx_cnt, detail::atomic_ref_wrapper<int>{.val = 1});
     m_stop_token    = m_ctx_cnt;
 }
@@ -38,12 +130,67 @@ auto scheduler::start_impl() noexcept -> void
 }
 
 auto scheduler::loop_impl() noexcept -> void
+{
+    [[CORO_MAYBE_UNUSED]] auto started = try_start_loop();
+    assert(started && "error! scheduler loop is already running");
+    run_loop();
+}
+
+auto scheduler::try_start_loop() noexcept -> bool
+{
+    std::lock_guard<std::mutex> lk(m_loop_mtx);
+    if (m_running.load(std::memory_order_acquire))
+    {
+        return false;
+    }
+    m_running.store(true, std::memory_order_release);
+    return true;
+}
+
+auto scheduler::run_loop() noexcept -> void
 {
     start_impl();
     for (int i = 0; i < m_ctx_cnt; i++)
     {
         m_ctxs[i]->join();
     }
+    // 重置停止计数, loop返回后可以继续提交任务并再次loop.
+    // 与m_running在同一临界区内修改, 持有引用后看到m_running为true的调用者一定会被该loop处理
+    std::lock_guard<std::mutex> lk(m_loop_mtx);
+    for (auto& flag : m_ctx_stop_flag)
+    {
+        flag.val = 1;
+    }
+    m_stop_token.store(m_ctx_cnt, std::memory_order_release);
+    m_running.store(false, std::memory_order_release);
+    // 唤醒在acquire_keep_alive中等待计数重置的线程
+    m_stop_token.notify_all();
+}
+
+auto scheduler::acquire_keep_alive() noexcept -> void
+{
+    auto cnt = m_stop_token.load(std::memory_order_acquire);
+    while (true)
+    {
+        if (cnt == 0)
+        {
+            // loop正在结束, 阻塞在计数上直到run_loop重置
+            m_stop_token.wait(0, std::memory_order_acquire);
+            cnt = m_stop_token.load(std::memory_order_acquire);
+        }
+        else if (m_stop_token.compare_exchange_weak(cnt, cnt + 1, std::memory_order_acq_rel, std::memory_order_acquire))
+        {
+            return;
+        }
+    }
+}
+
+auto scheduler::release_keep_alive() noexcept -> void
+{
+    if (m_stop_token.fetch_sub(1, std::memory_order_acq_rel) == 1)
+    {
+        stop_impl();
+    }
 }
 
 auto scheduler::stop_impl() noexcept -> void
@@ -55,13 +202,18 @@ auto scheduler::stop_impl() noexcept -> void
 }
 
 
-auto scheduler::submit_task_impl(std::coroutine_handle<> handle) noexcept -> void
+auto scheduler::submit_task_impl(std::coroutine_handle<> handle, task_priority prio) noexcept -> void
+{
+    submit_task_impl(handle, m_dispatcher.dispatch(), prio);
+}
+
+auto scheduler::submit_task_impl(std::coroutine_handle<> handle, size_t ctx_id, task_priority prio) noexcept -> void
 {
     assert(this->m_stop_token.load(std::memory_order_acquire) != 0 && "error! submit task after scheduler loop finish");
-    size_t ctx_id = m_dispatcher.dispatch();
+    assert(ctx_id < m_ctx_cnt && "error! ctx_id out of range");
     m_stop_token.fetch_add(
         1 - std::atomic_ref(m_ctx_stop_flag[ctx_id].val).fetch_or(1, memory_order_acq_rel), memory_order_acq_rel);
-    m_ctxs[ctx_id]->submit_task(handle);
+    m_ctxs[ctx_id]->submit_task(handle, prio);
 }
 
 
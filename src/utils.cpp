@@ -1,6 +1,17 @@
 
 #include <cassert>
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <dirent.h>
 #include <fcntl.h>
+#include <pthread.h>
+#include <sched.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+    #include <immintrin.h>
+#endif
 
 #include "coro/utils.hpp"
 
@@ -22,5 +33,126 @@ auto get_null_fd() noexcept -> int
     return fd;
 }
 
+auto get_allowed_cpus() noexcept -> std::vector<int>
+{
+    std::vector<int> cpus;
+    cpu_set_t        set;
+    CPU_ZERO(&set);
+    if (sched_getaffinity(0, sizeof(set), &set) != 0)
+    {
+        return cpus;
+    }
+    for (int i = 0; i < CPU_SETSIZE; i++)
+    {
+        if (CPU_ISSET(i, &set))
+        {
+            cpus.push_back(i);
+        }
+    }
+    return cpus;
+}
+
+auto pin_thread_to_cpu(int cpu) noexcept -> bool
+{
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+}
+
+auto get_numa_node(int cpu) noexcept -> int
+{
+    char path[64];
+    snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%d", cpu);
+    auto dir = opendir(path);
+    if (dir == nullptr)
+    {
+        return 0;
+    }
+
+    int node = 0;
+    while (auto entry = readdir(dir))
+    {
+        if (strncmp(entry->d_name, "node", 4) == 0 && isdigit(static_cast<unsigned char>(entry->d_name[4])))
+        {
+            node = atoi(entry->d_name + 4);
+            break;
+        }
+    }
+    closedir(dir);
+    return node;
+}
+
+
+namespace
+{
+auto find_byte_scalar(const char* data, size_t len, char c) noexcept -> size_t
+{
+    for (size_t i = 0; i < len; i++)
+    {
+        if (data[i] == c)
+        {
+            return i;
+        }
+    }
+    return len;
+}
+
+#if defined(__SSE2__)
+auto find_byte_sse2(const char* data, size_t len, char c) noexcept -> size_t
+{
+    const __m128i pattern = _mm_set1_epi8(c);
+
+    size_t i = 0;
+    for (; i + 16 <= len; i += 16)
+    {
+        auto chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        auto mask  = _mm_movemask_epi8(_mm_cmpeq_epi8(chunk, pattern));
+        if (mask != 0)
+        {
+            return i + __builtin_ctz(mask);
+        }
+    }
+    return i + find_byte_scalar(data + i, len - i, c);
+}
+#endif
+
+#if defined(__x86_64__) && defined(__GNUC__)
+    #define CORO_FIND_BYTE_AVX2
+__attribute__((target("avx2"))) auto find_byte_avx2(const char* data, size_t len, char c) noexcept -> size_t
+{
+    const __m256i pattern = _mm256_set1_epi8(c);
+
+    size_t i = 0;
+    for (; i + 32 <= len; i += 32)
+    {
+        auto chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+        auto mask  = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk, pattern)));
+        if (mask != 0)
+        {
+            return i + __builtin_ctz(mask);
+        }
+    }
+    return i + find_byte_sse2(data + i, len - i, c);
+}
+#endif
+}; // namespace
+
+auto find_byte(const char* data, size_t len, char c) noexcept -> size_t
+{
+#if defined(CORO_FIND_BYTE_AVX2)
+    // 短数据不值得进入向量循环
+    static const bool has_avx2 = __builtin_cpu_supports("avx2");
+    if (has_avx2 && len >= 32)
+    {
+        return find_byte_avx2(data, len, c);
+    }
+#endif
+#if defined(__SSE2__)
+    return find_byte_sse2(data, len, c);
+#else
+    return find_byte_scalar(data, len, c);
+#endif
+}
 
 }; // namespace coro::utils 
@@ -0,0 +1,130 @@
+#include <algorithm>
+#include <atomic>
+#include <tuple>
+#include <vector>
+
+#include "coro/coro.hpp"
+#include "coro/comp/barrier.hpp"
+#include "gtest/gtest.h"
+
+using namespace coro;
+
+/*************************************************************
+ *                       pre-definition                      *
+ *************************************************************/
+
+int main(int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
+
+class BarrierTest : public ::testing::TestWithParam<std::tuple<int, int>>
+{
+protected:
+    void SetUp() override
+    {
+        m_arrived = 0;
+        m_phases  = 0;
+        m_errors  = 0;
+    }
+
+    std::atomic<int> m_arrived; // 当前阶段已经到达的协程数, 由completion检查并清零
+    std::atomic<int> m_phases;  // completion执行的次数
+    std::atomic<int> m_errors;
+};
+
+class BarrierDropTest : public ::testing::Test
+{
+protected:
+    std::vector<int> m_vec;
+};
+
+task<> phase_func(
+    barrier& bar, std::atomic<int>& arrived, std::atomic<int>& phases, std::atomic<int>& errors, int phase_num)
+{
+    for (int i = 0; i < phase_num; i++)
+    {
+        arrived.fetch_add(1, std::memory_order_acq_rel);
+        auto gen = co_await bar.arrive_and_wait();
+        // 被唤醒时本阶段的completion已经执行完毕
+        if (gen != uint64_t(i) || phases.load(std::memory_order_acquire) != i + 1)
+        {
+            errors.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+}
+
+task<> drop_wait_func(barrier& bar, std::vector<int>& vec, int id)
+{
+    for (int i = 0; i < 3; i++)
+    {
+        auto gen = co_await bar.arrive_and_wait();
+        vec.push_back(id * 10 + int(gen));
+    }
+}
+
+task<> drop_func(barrier& bar)
+{
+    bar.arrive_and_drop();
+    co_return;
+}
+
+/*************************************************************
+ *                          tests                            *
+ *************************************************************/
+
+TEST_P(BarrierTest, PhasesWithCompletion)
+{
+    int thread_num, task_num;
+    std::tie(thread_num, task_num) = GetParam();
+
+    constexpr int kPhaseNum  = 10;
+    auto          completion = [&]()
+    {
+        if (m_arrived.exchange(0, std::memory_order_acq_rel) != task_num)
+        {
+            m_errors.fetch_add(1, std::memory_order_relaxed);
+        }
+        m_phases.fetch_add(1, std::memory_order_acq_rel);
+    };
+    barrier bar(task_num, completion);
+
+    scheduler::init(thread_num);
+    for (int i = 0; i < task_num; i++)
+    {
+        submit_to_scheduler(phase_func(bar, m_arrived, m_phases, m_errors, kPhaseNum));
+    }
+    scheduler::loop();
+
+    ASSERT_EQ(m_errors.load(), 0);
+    ASSERT_EQ(m_phases.load(), kPhaseNum);
+    ASSERT_EQ(bar.generation(), kPhaseNum);
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    BarrierTests,
+    BarrierTest,
+    ::testing::Values(
+        std::make_tuple(1, 1),
+        std::make_tuple(1, 100),
+        std::make_tuple(0, 100),
+        std::make_tuple(4, 100),
+        std::make_tuple(4, 1000)));
+
+TEST_F(BarrierDropTest, ArriveAndDrop)
+{
+    barrier bar(3);
+
+    scheduler::init(1);
+    submit_to_scheduler(drop_wait_func(bar, m_vec, 1));
+    submit_to_scheduler(drop_wait_func(bar, m_vec, 2));
+    // 第一个阶段凑齐三个到达, 之后每个阶段只需要两个
+    submit_to_scheduler(drop_func(bar));
+    scheduler::loop();
+
+    ASSERT_EQ(m_vec.size(), 6);
+    ASSERT_EQ(bar.generation(), 3);
+    std::sort(m_vec.begin(), m_vec.end());
+    ASSERT_EQ(m_vec, std::vector<int>({10, 11, 12, 20, 21, 22}));
+}
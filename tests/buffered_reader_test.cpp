@@ -0,0 +1,227 @@
+#include <algorithm>
+#include <coroutine>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "coro/coro.hpp"
+#include "coro/io/buffered_reader.hpp"
+#include "coro/utils.hpp"
+#include "gtest/gtest.h"
+
+using namespace coro;
+using io::buffered_reader;
+
+/*************************************************************
+ *                       pre-definition                      *
+ *************************************************************/
+
+int main(int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
+
+/**
+ * @brief 按预设的分片返回数据的connector, 用于模拟tcp流被任意切分
+ */
+struct fake_connector
+{
+    struct read_awaiter
+    {
+        constexpr auto await_ready() noexcept -> bool { return true; }
+
+        constexpr auto await_suspend(std::coroutine_handle<>) noexcept -> void {}
+
+        auto await_resume() noexcept -> int
+        {
+            if (m_conn.m_idx == m_conn.m_chunks.size())
+            {
+                return m_conn.m_error;
+            }
+            auto& chunk = m_conn.m_chunks[m_conn.m_idx];
+            auto  cnt   = std::min(chunk.size() - m_conn.m_off, m_len);
+            memcpy(m_buf, chunk.data() + m_conn.m_off, cnt);
+            m_conn.m_off += cnt;
+            if (m_conn.m_off == chunk.size())
+            {
+                m_conn.m_idx++;
+                m_conn.m_off = 0;
+            }
+            m_conn.m_reads++;
+            return static_cast<int>(cnt);
+        }
+
+        fake_connector& m_conn;
+        char*           m_buf;
+        size_t          m_len;
+    };
+
+    auto read(char* buf, size_t len) noexcept -> read_awaiter { return read_awaiter{*this, buf, len}; }
+
+    std::vector<std::string> m_chunks;
+    size_t                   m_idx{0};
+    size_t                   m_off{0};
+    int                      m_error{0}; // 数据读完后返回的值, 0表示EOF
+    int                      m_reads{0};
+};
+
+class BufferedReaderTest : public ::testing::Test
+{
+protected:
+    void SetUp() override {}
+
+    void TearDown() override {}
+
+    fake_connector           m_conn;
+    std::vector<std::string> m_vec;
+};
+
+task<> read_lines_func(fake_connector& conn, std::vector<std::string>& vec, size_t capacity)
+{
+    auto reader = buffered_reader<fake_connector>(conn, capacity);
+    while (true)
+    {
+        auto line = co_await reader.read_line();
+        if (!line)
+        {
+            break;
+        }
+        vec.emplace_back(*line);
+    }
+    vec.push_back(reader.eof() ? "eof" : std::to_string(reader.error()));
+}
+
+task<> read_exact_func(fake_connector& conn, std::vector<std::string>& vec)
+{
+    auto reader = buffered_reader<fake_connector>(conn, 16);
+
+    auto head = co_await reader.peek(2);
+    vec.emplace_back(head);
+
+    auto first = co_await reader.read_exact(3);
+    vec.emplace_back(first.value_or("null"));
+
+    std::string big(20, '\0');
+    auto        cnt = co_await reader.read_exact(big.data(), big.size());
+    vec.push_back(std::to_string(cnt));
+    vec.push_back(big);
+
+    auto rest = co_await reader.read_until("##");
+    vec.emplace_back(rest.value_or("null"));
+
+    auto none = co_await reader.read_exact(4);
+    vec.emplace_back(none.has_value() ? "value" : "null");
+    vec.push_back(reader.eof() ? "eof" : "no-eof");
+}
+
+task<> read_after_error_func(fake_connector& conn, std::vector<std::string>& vec)
+{
+    auto reader = buffered_reader<fake_connector>(conn, 8);
+
+    auto line = co_await reader.read_line();
+    vec.emplace_back(line.value_or("null"));
+    vec.push_back(std::to_string(reader.error()));
+
+    auto head = co_await reader.read_exact(4);
+    vec.emplace_back(head.value_or("null"));
+    vec.push_back(std::to_string(reader.error()));
+}
+
+/*************************************************************
+ *                          tests                            *
+ *************************************************************/
+
+TEST(FindByteTest, MatchesScalar)
+{
+    std::string data(300, 'a');
+    ASSERT_EQ(utils::find_byte(data.data(), data.size(), 'b'), data.size());
+    ASSERT_EQ(utils::find_byte(data.data(), 0, 'a'), 0);
+
+    // 覆盖向量循环内, 循环边界与尾部的各种位置
+    for (size_t pos : {0, 1, 15, 16, 17, 31, 32, 33, 63, 64, 200, 299})
+    {
+        data[pos] = 'b';
+        ASSERT_EQ(utils::find_byte(data.data(), data.size(), 'b'), pos);
+        for (size_t start = 0; start <= pos; start += 7)
+        {
+            ASSERT_EQ(utils::find_byte(data.data() + start, data.size() - start, 'b'), pos - start);
+        }
+        data[pos] = 'a';
+    }
+}
+
+TEST_F(BufferedReaderTest, ReadLineAcrossChunks)
+{
+    m_conn.m_chunks = {"hel", "lo\r\nwor", "ld\n\npartial"};
+
+    scheduler::init(1);
+    submit_to_scheduler(read_lines_func(m_conn, m_vec, 16));
+    scheduler::loop();
+
+    ASSERT_EQ(m_vec.size(), 4);
+    ASSERT_EQ(m_vec[0], "hello");
+    ASSERT_EQ(m_vec[1], "world");
+    ASSERT_EQ(m_vec[2], "");
+    ASSERT_EQ(m_vec[3], "eof");
+}
+
+TEST_F(BufferedReaderTest, ReadLineOverflow)
+{
+    m_conn.m_chunks = {"0123456789", "abcdef\n"};
+
+    scheduler::init(1);
+    submit_to_scheduler(read_lines_func(m_conn, m_vec, 8));
+    scheduler::loop();
+
+    ASSERT_EQ(m_vec.size(), 1);
+    ASSERT_EQ(m_vec[0], std::to_string(-ENOBUFS));
+}
+
+TEST_F(BufferedReaderTest, ErrorClearedOnNextRead)
+{
+    m_conn.m_chunks = {"0123456789", "ab\n"};
+
+    scheduler::init(1);
+    submit_to_scheduler(read_after_error_func(m_conn, m_vec));
+    scheduler::loop();
+
+    ASSERT_EQ(m_vec.size(), 4);
+    ASSERT_EQ(m_vec[0], "null");
+    ASSERT_EQ(m_vec[1], std::to_string(-ENOBUFS));
+    ASSERT_EQ(m_vec[2], "0123");
+    ASSERT_EQ(m_vec[3], "0");
+}
+
+TEST_F(BufferedReaderTest, ReadLineError)
+{
+    m_conn.m_chunks = {"line\nbroken"};
+    m_conn.m_error  = -ECONNRESET;
+
+    scheduler::init(1);
+    submit_to_scheduler(read_lines_func(m_conn, m_vec, 16));
+    scheduler::loop();
+
+    ASSERT_EQ(m_vec.size(), 2);
+    ASSERT_EQ(m_vec[0], "line");
+    ASSERT_EQ(m_vec[1], std::to_string(-ECONNRESET));
+}
+
+TEST_F(BufferedReaderTest, ReadExactAndUntil)
+{
+    m_conn.m_chunks = {"abcdef", "0123456789abcdefghijklmn", "op##"};
+
+    scheduler::init(1);
+    submit_to_scheduler(read_exact_func(m_conn, m_vec));
+    scheduler::loop();
+
+    ASSERT_EQ(m_vec.size(), 7);
+    ASSERT_EQ(m_vec[0], "ab");
+    ASSERT_EQ(m_vec[1], "abc");
+    ASSERT_EQ(m_vec[2], "20");
+    ASSERT_EQ(m_vec[3], "def0123456789abcdefg");
+    ASSERT_EQ(m_vec[4], "hijklmnop##");
+    ASSERT_EQ(m_vec[5], "null");
+    ASSERT_EQ(m_vec[6], "eof");
+}
@@ -0,0 +1,221 @@
+#include <atomic>
+#include <memory>
+#include <tuple>
+#include <vector>
+
+#include "coro/coro.hpp"
+#include "coro/comp/channel.hpp"
+#include "gtest/gtest.h"
+
+using namespace coro;
+
+/*************************************************************
+ *                       pre-definition                      *
+ *************************************************************/
+
+int main(int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
+
+class ChannelTest : public ::testing::TestWithParam<size_t>
+{
+protected:
+    void SetUp() override {}
+
+    void TearDown() override {}
+
+    std::vector<int> m_vec;
+};
+
+class ChannelMpmcTest : public ::testing::TestWithParam<std::tuple<int, int, size_t>>
+{
+protected:
+    void SetUp() override
+    {
+        m_sum       = 0;
+        m_recv_cnt  = 0;
+        m_producers = 0;
+    }
+
+    std::atomic<long> m_sum;
+    std::atomic<int>  m_recv_cnt;
+    std::atomic<int>  m_producers; // 尚未结束的生产者数量, 最后一个结束的生产者关闭channel
+};
+
+task<> send_func(channel<int>& ch, int num)
+{
+    for (int i = 0; i < num; i++)
+    {
+        co_await ch.send(i);
+    }
+    ch.close();
+}
+
+task<> recv_func(channel<int>& ch, std::vector<int>& vec)
+{
+    while (true)
+    {
+        auto value = co_await ch.recv();
+        if (!value)
+        {
+            break;
+        }
+        vec.push_back(*value);
+    }
+}
+
+task<> mpmc_send_func(channel<int>& ch, std::atomic<int>& producers, int num)
+{
+    for (int i = 1; i <= num; i++)
+    {
+        co_await ch.send(i);
+    }
+    if (producers.fetch_sub(1, std::memory_order_acq_rel) == 1)
+    {
+        ch.close();
+    }
+}
+
+task<> mpmc_recv_func(channel<int>& ch, std::atomic<long>& sum, std::atomic<int>& cnt)
+{
+    while (true)
+    {
+        auto value = co_await ch.recv();
+        if (!value)
+        {
+            break;
+        }
+        sum.fetch_add(*value, std::memory_order_relaxed);
+        cnt.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+task<> close_recv_func(channel<int>& ch, std::vector<int>& vec)
+{
+    auto value = co_await ch.recv();
+    vec.push_back(value.has_value() ? *value : -1);
+}
+
+task<> close_func(channel<int>& ch, std::vector<int>& vec)
+{
+    ch.close();
+    bool ok = co_await ch.send(1);
+    vec.push_back(ok ? 1 : 0);
+}
+
+task<> move_only_func(channel<std::unique_ptr<int>>& ch, std::vector<int>& vec)
+{
+    co_await ch.send(std::make_unique<int>(7));
+    auto value = co_await ch.recv();
+    vec.push_back(**value);
+}
+
+/*************************************************************
+ *                          tests                            *
+ *************************************************************/
+
+TEST_P(ChannelTest, SendAndRecvInOrder)
+{
+    channel<int> ch(GetParam());
+
+    scheduler::init(1);
+    submit_to_scheduler(recv_func(ch, m_vec));
+    submit_to_scheduler(send_func(ch, 100));
+    scheduler::loop();
+
+    ASSERT_EQ(m_vec.size(), 100);
+    for (int i = 0; i < 100; i++)
+    {
+        ASSERT_EQ(m_vec[i], i);
+    }
+}
+
+TEST_P(ChannelTest, CloseWakesReceivers)
+{
+    channel<int> ch(GetParam());
+
+    scheduler::init(1);
+    for (int i = 0; i < 10; i++)
+    {
+        submit_to_scheduler(close_recv_func(ch, m_vec));
+    }
+    submit_to_scheduler(close_func(ch, m_vec));
+    scheduler::loop();
+
+    // close之后的发送立即失败, 先于被唤醒的接收者记录
+    ASSERT_EQ(m_vec.size(), 11);
+    ASSERT_EQ(m_vec[0], 0);
+    for (int i = 1; i <= 10; i++)
+    {
+        ASSERT_EQ(m_vec[i], -1);
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(ChannelTests, ChannelTest, ::testing::Values(0, 1, 4, 128));
+
+TEST(ChannelBaseTest, TrySendAndTryRecv)
+{
+    channel<int> ch(2);
+    int          a = 1, b = 2, c = 3;
+    ASSERT_TRUE(ch.try_send(a));
+    ASSERT_TRUE(ch.try_send(b));
+    ASSERT_FALSE(ch.try_send(c));
+    ASSERT_EQ(ch.try_recv(), 1);
+    ASSERT_EQ(ch.try_recv(), 2);
+    ASSERT_FALSE(ch.try_recv().has_value());
+
+    // 关闭后缓冲区中剩余的数据仍然可以取出
+    ASSERT_TRUE(ch.try_send(c));
+    ch.close();
+    ASSERT_FALSE(ch.try_send(a));
+    ASSERT_EQ(ch.try_recv(), 3);
+    ASSERT_FALSE(ch.try_recv().has_value());
+}
+
+TEST(ChannelBaseTest, MoveOnlyValue)
+{
+    channel<std::unique_ptr<int>> ch(1);
+    std::vector<int>              vec;
+
+    scheduler::init(1);
+    submit_to_scheduler(move_only_func(ch, vec));
+    scheduler::loop();
+
+    ASSERT_EQ(vec.size(), 1);
+    ASSERT_EQ(vec[0], 7);
+}
+
+TEST_P(ChannelMpmcTest, MultiProducerMultiConsumer)
+{
+    int    thread_num, task_num;
+    size_t capacity;
+    std::tie(thread_num, task_num, capacity) = GetParam();
+
+    constexpr int kLoop = 100;
+    channel<int>  ch(capacity);
+    m_producers = task_num;
+
+    scheduler::init(thread_num);
+    for (int i = 0; i < task_num; i++)
+    {
+        submit_to_scheduler(mpmc_recv_func(ch, m_sum, m_recv_cnt));
+        submit_to_scheduler(mpmc_send_func(ch, m_producers, kLoop));
+    }
+    scheduler::loop();
+
+    ASSERT_EQ(m_recv_cnt.load(), task_num * kLoop);
+    ASSERT_EQ(m_sum.load(), long(task_num) * (kLoop * (kLoop + 1) / 2));
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    ChannelMpmcTests,
+    ChannelMpmcTest,
+    ::testing::Values(
+        std::make_tuple(1, 10, 0),
+        std::make_tuple(1, 10, 16),
+        std::make_tuple(0, 100, 0),
+        std::make_tuple(0, 100, 16),
+        std::make_tuple(4, 100, 0),
+        std::make_tuple(4, 100, 16)));
@@ -0,0 +1,158 @@
+#include <atomic>
+#include <deque>
+#include <tuple>
+#include <vector>
+
+#include "coro/coro.hpp"
+#include "coro/comp/condition_variable.hpp"
+#include "coro/comp/mutex.hpp"
+#include "gtest/gtest.h"
+
+using namespace coro;
+
+/*************************************************************
+ *                       pre-definition                      *
+ *************************************************************/
+
+int main(int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
+
+struct shared_queue
+{
+    mutex              mtx;
+    condition_variable cv;
+    std::deque<int>    que;         // 由mtx保护
+    int                producers{0}; // 尚未结束的生产者数量, 由mtx保护
+    int                sum{0};       // 消费者累加的结果, 由mtx保护
+};
+
+class ConditionVariableTest : public ::testing::TestWithParam<std::tuple<int, int>>
+{
+protected:
+    shared_queue m_sq;
+};
+
+class ConditionVariableNotifyAllTest : public ::testing::TestWithParam<std::tuple<int, int>>
+{
+protected:
+    void SetUp() override { m_woken = 0; }
+
+    mutex              m_mtx;
+    condition_variable m_cv;
+    bool               m_ready{false};
+    std::atomic<int>   m_woken;
+};
+
+task<> producer_func(shared_queue& sq, int loop)
+{
+    for (int i = 1; i <= loop; i++)
+    {
+        co_await sq.mtx.lock();
+        sq.que.push_back(i);
+        sq.mtx.unlock();
+        sq.cv.notify_one();
+    }
+
+    co_await sq.mtx.lock();
+    sq.producers--;
+    sq.mtx.unlock();
+    sq.cv.notify_all();
+}
+
+task<> consumer_func(shared_queue& sq)
+{
+    while (true)
+    {
+        co_await sq.mtx.lock();
+        co_await sq.cv.wait(sq.mtx, [&]() { return !sq.que.empty() || sq.producers == 0; });
+        if (sq.que.empty())
+        {
+            sq.mtx.unlock();
+            break;
+        }
+        sq.sum += sq.que.front();
+        sq.que.pop_front();
+        sq.mtx.unlock();
+    }
+}
+
+task<> wait_ready_func(mutex& mtx, condition_variable& cv, bool& ready, std::atomic<int>& woken)
+{
+    co_await mtx.lock();
+    co_await cv.wait(mtx, [&]() { return ready; });
+    woken.fetch_add(1, std::memory_order_acq_rel);
+    mtx.unlock();
+}
+
+task<> set_ready_func(mutex& mtx, condition_variable& cv, bool& ready)
+{
+    co_await mtx.lock();
+    ready = true;
+    mtx.unlock();
+    cv.notify_all();
+}
+
+/*************************************************************
+ *                          tests                            *
+ *************************************************************/
+
+TEST_P(ConditionVariableTest, ProducerConsumer)
+{
+    int thread_num, task_num;
+    std::tie(thread_num, task_num) = GetParam();
+
+    constexpr int kLoop = 100;
+    m_sq.producers      = task_num;
+
+    scheduler::init(thread_num);
+    for (int i = 0; i < task_num; i++)
+    {
+        submit_to_scheduler(consumer_func(m_sq));
+    }
+    for (int i = 0; i < task_num; i++)
+    {
+        submit_to_scheduler(producer_func(m_sq, kLoop));
+    }
+    scheduler::loop();
+
+    ASSERT_TRUE(m_sq.que.empty());
+    ASSERT_EQ(m_sq.sum, task_num * (kLoop * (kLoop + 1) / 2));
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    ConditionVariableTests,
+    ConditionVariableTest,
+    ::testing::Values(
+        std::make_tuple(1, 1),
+        std::make_tuple(1, 10),
+        std::make_tuple(0, 1),
+        std::make_tuple(0, 10),
+        std::make_tuple(4, 100)));
+
+TEST_P(ConditionVariableNotifyAllTest, NotifyAll)
+{
+    int thread_num, wait_num;
+    std::tie(thread_num, wait_num) = GetParam();
+
+    scheduler::init(thread_num);
+    for (int i = 0; i < wait_num; i++)
+    {
+        submit_to_scheduler(wait_ready_func(m_mtx, m_cv, m_ready, m_woken));
+    }
+    submit_to_scheduler(set_ready_func(m_mtx, m_cv, m_ready));
+    scheduler::loop();
+
+    ASSERT_EQ(m_woken.load(), wait_num);
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    ConditionVariableNotifyAllTests,
+    ConditionVariableNotifyAllTest,
+    ::testing::Values(
+        std::make_tuple(1, 1),
+        std::make_tuple(1, 100),
+        std::make_tuple(0, 100),
+        std::make_tuple(4, 1000)));
@@ -1,11 +1,16 @@
 #include <algorithm>
+#include <atomic>
 #include <coroutine>
 #include <mutex>
+#include <sched.h>
 #include <thread>
 #include <vector>
 
+#include "coro/comp/channel.hpp"
 #include "coro/io/io_awaiter.hpp"
 #include "coro/scheduler.hpp"
+#include "coro/utils.hpp"
+#include "coro/yield.hpp"
 #include "gtest/gtest.h"
 
 using namespace coro;
@@ -56,6 +61,16 @@ class SchedulerSubmitTest : public ContextRunTaskTest
 {
 };
 
+class ContextPriorityTest : public ::testing::TestWithParam<int>
+{
+protected:
+    // 测试在启动前提交大量high与low任务, 需要与normal队列相同的容量, 开启lifo以测试经过next slot的唤醒
+    context          m_ctx{
+        engine_options{.prio_queue_cap = config::kQueCap, .schedule = detail::schedule_strategy::lifo}};
+    std::vector<int> m_vec;
+    std::mutex       m_mtx;
+};
+
 class SchedulerRunTaskTest : public ::testing::TestWithParam<int>
 {
 protected:
@@ -71,6 +86,18 @@ class SchedulerAddNopIOTest : public SchedulerRunTaskTest
 {
 };
 
+class SchedulerSubmitToContextTest : public SchedulerRunTaskTest
+{
+};
+
+class SchedulerAffinityTest : public ::testing::TestWithParam<int>
+{
+};
+
+class SchedulerInstanceTest : public ::testing::TestWithParam<int>
+{
+};
+
 
 task<> func(std::vector<int>& vec, int val)
 {
@@ -102,6 +129,158 @@ task<> mutex_func_nop(std::vector<int>& vec, int val, std::mutex& mtx)
     co_return;
 }
 
+task<> record_ctx_func(std::vector<int>& vec, int target, std::mutex& mtx)
+{
+    co_await noop_awaiter{};
+    mtx.lock();
+    vec.push_back(target);
+    vec.push_back(local_context().get_index());
+    mtx.unlock();
+    co_return;
+}
+
+task<> prio_nop_func(std::vector<int>& vec, std::mutex& mtx)
+{
+    co_await noop_awaiter{};
+    mtx.lock();
+    vec.push_back(static_cast<int>(detail::linfo.prio));
+    mtx.unlock();
+    co_return;
+}
+
+task<> prio_recv_func(channel<int>& ch, std::vector<int>& vec, std::mutex& mtx)
+{
+    co_await ch.recv();
+    mtx.lock();
+    vec.push_back(static_cast<int>(detail::linfo.prio));
+    mtx.unlock();
+}
+
+/**
+ * @brief 以high优先级不断让出, 直到low优先级的任务设置flag
+ */
+task<> hog_func(std::atomic<bool>& flag, std::atomic<int>& spins)
+{
+    while (!flag.load(std::memory_order_acquire))
+    {
+        spins.fetch_add(1, std::memory_order_relaxed);
+        co_await yield();
+    }
+}
+
+task<> low_set_func(std::atomic<bool>& flag, std::atomic<int>& spins, int& seen)
+{
+    seen = spins.load(std::memory_order_relaxed);
+    flag.store(true, std::memory_order_release);
+    co_return;
+}
+
+task<> prio_send_func(channel<int>& ch, int num)
+{
+    for (int i = 0; i < num; i++)
+    {
+        co_await ch.send(i);
+    }
+}
+
+task<int> ctx_id_func()
+{
+    co_return static_cast<int>(local_context().get_index());
+}
+
+task<> spawn_local_func(int task_num, int& mismatch)
+{
+    int self = local_context().get_index();
+    for (int i = 0; i < task_num; i++)
+    {
+        auto id = co_await scheduler::spawn_local(ctx_id_func());
+        mismatch += id != self ? 1 : 0;
+    }
+}
+
+task<> spawn_on_func(int task_num, int& mismatch)
+{
+    int ctx_cnt = scheduler::context_count();
+    for (int i = 0; i < task_num; i++)
+    {
+        auto id = co_await scheduler::spawn_on(i % ctx_cnt, ctx_id_func());
+        mismatch += id != i % ctx_cnt ? 1 : 0;
+    }
+}
+
+task<> switch_func(int task_num, int& mismatch)
+{
+    int ctx_cnt = scheduler::context_count();
+    for (int i = 0; i < task_num; i++)
+    {
+        co_await switch_to(i % ctx_cnt);
+        mismatch += static_cast<int>(local_context().get_index()) != i % ctx_cnt ? 1 : 0;
+        co_await noop_awaiter{};
+        mismatch += static_cast<int>(local_context().get_index()) != i % ctx_cnt ? 1 : 0;
+    }
+}
+
+/**
+ * @brief 子任务检查自己运行在期望的scheduler上, 并且使用该scheduler的engine参数
+ */
+task<int> check_scheduler_func(scheduler* expect)
+{
+    co_await noop_awaiter{};
+    bool ok = &scheduler::current() == expect && local_context().get_index() < expect->size() &&
+              scheduler::context_count() == expect->size() &&
+              local_context().get_engine().get_options().entry_length == expect->options().engine_opts.entry_length;
+    co_return ok ? 0 : 1;
+}
+
+/**
+ * @brief 依次迁移到每个context上, 记录context id
+ */
+task<> collect_id_func(std::vector<config::ctx_id>& ids)
+{
+    for (size_t i = 0; i < scheduler::context_count(); i++)
+    {
+        co_await switch_to(i);
+        ids.push_back(local_context().get_ctx_id());
+    }
+}
+
+task<int> instance_func(scheduler* expect, int task_num)
+{
+    std::vector<future<int>> futs;
+    for (int i = 0; i < task_num; i++)
+    {
+        futs.push_back(scheduler::spawn(check_scheduler_func(expect)));
+    }
+    int mismatch = 0;
+    for (auto& fut : futs)
+    {
+        mismatch += co_await fut;
+    }
+    co_await switch_to(expect->size() - 1);
+    mismatch += local_context().get_index() != expect->size() - 1 ? 1 : 0;
+    co_return mismatch;
+}
+
+/**
+ * @brief 依次在每个context上发起IO, 记录各context的io_uring是否共享了io-wq线程池
+ */
+task<> attach_wq_func(std::vector<int>& vec)
+{
+    for (size_t i = 0; i < scheduler::context_count(); i++)
+    {
+        co_await switch_to(i);
+        co_await noop_awaiter{};
+        vec.push_back(detail::local_engine().get_uring().wq_attached() ? 1 : 0);
+    }
+}
+
+task<> record_cpu_func(std::vector<int>& vec)
+{
+    vec.push_back(sched_getcpu());
+    co_await noop_awaiter{};
+    vec.push_back(sched_getcpu());
+}
+
 task<> submit_scheduler_func(std::vector<int>& vec, int id)
 {
     if (id == 0)
@@ -248,6 +427,163 @@ TEST_P(ContextAddNopIOTest, AddNopIO)
 
 INSTANTIATE_TEST_SUITE_P(ContextAddNopIOTests, ContextAddNopIOTest, ::testing::Values(1, 10, 100, 10000));
 
+// 测试context的工作线程绑定到指定的CPU上, IO恢复后仍在该CPU上运行
+TEST_F(ContextTest, PinToCpu)
+{
+    auto cpus = utils::get_allowed_cpus();
+    ASSERT_FALSE(cpus.empty());
+
+    m_ctx.set_cpu(cpus.back());
+    ASSERT_EQ(m_ctx.get_cpu(), cpus.back());
+    m_ctx.submit_task(record_cpu_func(m_vec));
+
+    m_ctx.start();
+    m_ctx.join();
+
+    ASSERT_EQ(m_vec, std::vector<int>({cpus.back(), cpus.back()}));
+}
+
+// 测试context分布在两个NUMA节点上时, 工作线程只向本节点的context分发任务
+TEST(DispatcherTest, SameNodeRoundRobin)
+{
+    const int ctx_cnt = 4;
+
+    ASSERT_GE(utils::get_numa_node(utils::get_allowed_cpus().front()), 0);
+
+    detail::init_meta_info();
+    scheduler             owner(scheduler_options{.ctx_cnt = 1});
+    detail::ctx_container ctxs;
+    for (int i = 0; i < ctx_cnt; i++)
+    {
+        ctxs.emplace_back(std::make_unique<context>());
+        ctxs.back()->set_node(i % 2);
+        ctxs.back()->set_scheduler(&owner);
+    }
+    detail::dispatcher<detail::dispatch_strategy::round_robin> dispatcher;
+    dispatcher.init(ctx_cnt, &ctxs, &owner);
+
+    // 非工作线程在全部context之间轮转
+    std::vector<size_t> ids;
+    for (int i = 0; i < ctx_cnt; i++)
+    {
+        ids.push_back(dispatcher.dispatch());
+    }
+    std::sort(ids.begin(), ids.end());
+    ASSERT_EQ(ids, std::vector<size_t>({0, 1, 2, 3}));
+
+    // 模拟运行在节点1的context 1上
+    detail::linfo.ctx = ctxs[1].get();
+    for (int i = 0; i < 2 * ctx_cnt; i++)
+    {
+        auto id = dispatcher.dispatch();
+        ASSERT_TRUE(id == 1 || id == 3);
+    }
+
+    // 其他scheduler的工作线程即使id相同, 也在全部context之间轮转
+    context foreign(1, engine_options{});
+    foreign.set_node(1);
+    detail::linfo.ctx = &foreign;
+    ids.clear();
+    for (int i = 0; i < ctx_cnt; i++)
+    {
+        ids.push_back(dispatcher.dispatch());
+    }
+    std::sort(ids.begin(), ids.end());
+    ASSERT_EQ(ids, std::vector<size_t>({0, 1, 2, 3}));
+    detail::linfo.ctx = nullptr;
+}
+
+// 测试context按优先级执行任务, 低优先级的任务先提交也要等高优先级的任务执行完
+TEST_P(ContextPriorityTest, RunPriorityTask)
+{
+    const int task_num = GetParam();
+
+    for (int i = 0; i < task_num; i++)
+    {
+        m_ctx.submit_task(func(m_vec, 2), task_priority::low);
+    }
+    for (int i = 0; i < task_num; i++)
+    {
+        m_ctx.submit_task(func(m_vec, 1));
+    }
+    for (int i = 0; i < task_num; i++)
+    {
+        m_ctx.submit_task(func(m_vec, 0), task_priority::high);
+    }
+
+    m_ctx.start();
+    m_ctx.join();
+
+    ASSERT_EQ(m_vec.size(), 3 * task_num);
+    ASSERT_TRUE(std::is_sorted(m_vec.begin(), m_vec.end()));
+}
+
+// 测试IO完成后协程按原有的优先级重新入队
+TEST_P(ContextPriorityTest, IOKeepPriority)
+{
+    const int task_num = GetParam();
+
+    for (int i = 0; i < task_num; i++)
+    {
+        m_ctx.submit_task(prio_nop_func(m_vec, m_mtx), task_priority::low);
+        m_ctx.submit_task(prio_nop_func(m_vec, m_mtx), task_priority::high);
+    }
+
+    m_ctx.start();
+    m_ctx.join();
+
+    ASSERT_EQ(m_vec.size(), 2 * task_num);
+    ASSERT_EQ(std::count(m_vec.begin(), m_vec.end(), static_cast<int>(task_priority::high)), task_num);
+    ASSERT_EQ(std::count(m_vec.begin(), m_vec.end(), static_cast<int>(task_priority::low)), task_num);
+}
+
+// 测试同一context内被唤醒的协程经过next slot后仍按自己的优先级运行
+TEST_P(ContextPriorityTest, WakeupKeepPriority)
+{
+    const int task_num = GetParam();
+
+    channel<int> ch(0);
+    for (int i = 0; i < task_num; i++)
+    {
+        m_ctx.submit_task(prio_recv_func(ch, m_vec, m_mtx), task_priority::high);
+        m_ctx.submit_task(prio_recv_func(ch, m_vec, m_mtx));
+    }
+    // 发送者最后运行, 此时全部接收者都已挂起
+    m_ctx.submit_task(prio_send_func(ch, 2 * task_num), task_priority::low);
+
+    m_ctx.start();
+    m_ctx.join();
+
+    ASSERT_EQ(m_vec.size(), 2 * task_num);
+    ASSERT_EQ(std::count(m_vec.begin(), m_vec.end(), static_cast<int>(task_priority::high)), task_num);
+    ASSERT_EQ(std::count(m_vec.begin(), m_vec.end(), static_cast<int>(task_priority::normal)), task_num);
+}
+
+// 测试high任务持续占满每轮的预算时, low任务依靠prio_quota仍能执行
+TEST(ContextPriorityQuotaTest, LowProgressUnderHighLoad)
+{
+    constexpr int kHogNum = 16;
+
+    std::atomic<bool> flag{false};
+    std::atomic<int>  spins{0};
+    int               seen = -1;
+
+    context ctx{engine_options{.task_budget = 4, .prio_quota = 1}};
+    for (int i = 0; i < kHogNum; i++)
+    {
+        ctx.submit_task(hog_func(flag, spins), task_priority::high);
+    }
+    ctx.submit_task(low_set_func(flag, spins, seen), task_priority::low);
+
+    ctx.start();
+    ctx.join();
+
+    ASSERT_TRUE(flag.load());
+    ASSERT_GE(seen, 1);
+}
+
+INSTANTIATE_TEST_SUITE_P(ContextPriorityTests, ContextPriorityTest, ::testing::Values(1, 10, 100, 10000));
+
 /*************************************************************
  *                       test-scheduler                      *
  *************************************************************/
@@ -318,3 +654,158 @@ TEST_P(SchedulerAddNopIOTest, AddNopIO)
 }
 
 INSTANTIATE_TEST_SUITE_P(SchedulerAddNopIOTests, SchedulerAddNopIOTest, ::testing::Values(1, 10, 100, 10000));
+
+// 测试scheduler能否把任务提交到指定的context
+TEST_P(SchedulerSubmitToContextTest, SubmitToContext)
+{
+    const int task_num = GetParam();
+    const int ctx_cnt  = 4;
+    scheduler::init(ctx_cnt);
+    ASSERT_EQ(scheduler::context_count(), ctx_cnt);
+
+    for (int i = 0; i < task_num; i++)
+    {
+        scheduler::submit(record_ctx_func(m_vec, i % ctx_cnt, m_mtx), i % ctx_cnt);
+    }
+
+    scheduler::loop();
+
+    ASSERT_EQ(m_vec.size(), 2 * task_num);
+    std::vector<int> ids(ctx_cnt, -1);
+    for (int i = 0; i < task_num; i++)
+    {
+        int target = m_vec[2 * i];
+        int id     = m_vec[2 * i + 1];
+        if (ids[target] == -1)
+        {
+            ids[target] = id;
+        }
+        ASSERT_EQ(ids[target], id);
+    }
+    std::sort(ids.begin(), ids.end());
+    ASSERT_EQ(std::unique(ids.begin(), ids.end()), ids.end());
+}
+
+INSTANTIATE_TEST_SUITE_P(SchedulerSubmitToContextTests, SchedulerSubmitToContextTest, ::testing::Values(4, 100, 1000));
+
+// 测试spawn_local提交的子任务与父任务运行在同一context
+TEST_P(SchedulerAffinityTest, SpawnLocal)
+{
+    const int task_num = GetParam();
+    int       mismatch = 0;
+    scheduler::init(4);
+
+    sync_wait(spawn_local_func(task_num, mismatch));
+
+    ASSERT_EQ(mismatch, 0);
+}
+
+// 测试spawn_on把子任务提交到指定的context
+TEST_P(SchedulerAffinityTest, SpawnOn)
+{
+    const int task_num = GetParam();
+    int       mismatch = 0;
+    scheduler::init(4);
+
+    sync_wait(spawn_on_func(task_num, mismatch));
+
+    ASSERT_EQ(mismatch, 0);
+}
+
+// 测试switch_to迁移协程, 之后的IO也在新的context上完成
+TEST_P(SchedulerAffinityTest, SwitchTo)
+{
+    const int task_num = GetParam();
+    int       mismatch = 0;
+    scheduler::init(4);
+
+    sync_wait(switch_func(task_num, mismatch));
+
+    ASSERT_EQ(mismatch, 0);
+}
+
+INSTANTIATE_TEST_SUITE_P(SchedulerAffinityTests, SchedulerAffinityTest, ::testing::Values(1, 10, 1000));
+
+// 测试同时运行两个参数不同的scheduler实例, 任务中调用的静态接口只作用于所属的实例
+TEST_P(SchedulerInstanceTest, RunTwoInstances)
+{
+    const int task_num = GetParam();
+
+    scheduler small(
+        scheduler_options{.ctx_cnt = 2, .engine_opts = engine_options{.entry_length = 64, .queue_cap = 4096}});
+    scheduler large(scheduler_options{.ctx_cnt = 3});
+    ASSERT_EQ(small.size(), 2);
+    ASSERT_EQ(large.size(), 3);
+    ASSERT_EQ(small.options().engine_opts.entry_length, 64);
+
+    int         small_mismatch = -1;
+    std::thread th([&]() { small_mismatch = sync_wait(small, instance_func(&small, task_num)); });
+    int         large_mismatch = sync_wait(large, instance_func(&large, task_num));
+    th.join();
+
+    ASSERT_EQ(small_mismatch, 0);
+    ASSERT_EQ(large_mismatch, 0);
+    ASSERT_FALSE(small.running());
+    ASSERT_FALSE(large.running());
+}
+
+// 测试不同scheduler的context下标相同但context id全局唯一
+TEST(SchedulerOptionsTest, UniqueCtxIdAcrossInstances)
+{
+    scheduler first(scheduler_options{.ctx_cnt = 2});
+    scheduler second(scheduler_options{.ctx_cnt = 3});
+
+    std::vector<config::ctx_id> ids;
+    sync_wait(first, collect_id_func(ids));
+    sync_wait(second, collect_id_func(ids));
+
+    ASSERT_EQ(ids.size(), 5);
+    std::sort(ids.begin(), ids.end());
+    ASSERT_EQ(std::unique(ids.begin(), ids.end()), ids.end());
+}
+
+// 测试按参数初始化默认的scheduler
+TEST(SchedulerOptionsTest, InitDefaultWithOptions)
+{
+    scheduler::init(scheduler_options{.ctx_cnt = 2, .engine_opts = engine_options{.entry_length = 128}});
+    ASSERT_EQ(scheduler::context_count(), 2);
+    ASSERT_EQ(scheduler::current().options().engine_opts.entry_length, 128);
+
+    int mismatch = sync_wait(instance_func(&scheduler::current(), 10));
+    ASSERT_EQ(mismatch, 0);
+}
+
+// 测试第一个创建的io_uring独立创建, 之后创建的io_uring通过ATTACH_WQ共享其io-wq线程池
+TEST(SchedulerOptionsTest, AttachWq)
+{
+    const int ctx_cnt = 4;
+
+    std::vector<int> vec;
+    scheduler        sched(scheduler_options{.ctx_cnt = ctx_cnt, .engine_opts = engine_options{.sqpoll = false}});
+    sync_wait(sched, attach_wq_func(vec));
+    ASSERT_EQ(vec, std::vector<int>({0, 1, 1, 1}));
+
+    vec.clear();
+    scheduler single(scheduler_options{.ctx_cnt = ctx_cnt, .engine_opts = engine_options{.attach_wq = false}});
+    sync_wait(single, attach_wq_func(vec));
+    ASSERT_EQ(vec, std::vector<int>(ctx_cnt, 0));
+}
+
+// 测试开启sqpoll时默认不共享io-wq线程池, 只有显式设置attach_wq_sqpoll才共享
+TEST(SchedulerOptionsTest, AttachWqWithSqpoll)
+{
+    const int ctx_cnt = 4;
+
+    std::vector<int> vec;
+    scheduler        sched(scheduler_options{.ctx_cnt = ctx_cnt, .engine_opts = engine_options{.sqpoll = true}});
+    sync_wait(sched, attach_wq_func(vec));
+    ASSERT_EQ(vec, std::vector<int>(ctx_cnt, 0));
+
+    vec.clear();
+    scheduler shared(scheduler_options{
+        .ctx_cnt = ctx_cnt, .engine_opts = engine_options{.sqpoll = true, .attach_wq_sqpoll = true}});
+    sync_wait(shared, attach_wq_func(vec));
+    ASSERT_EQ(vec, std::vector<int>({0, 1, 1, 1}));
+}
+
+INSTANTIATE_TEST_SUITE_P(SchedulerInstanceTests, SchedulerInstanceTest, ::testing::Values(1, 10, 1000));
@@ -37,7 +37,8 @@ protected:
 
     void TearDown() override { m_engine.deinit(); }
 
-    detail::engine m_engine;
+    // 开启lifo以测试next slot, 只影响submit_next
+    detail::engine m_engine{engine_options{.schedule = detail::schedule_strategy::lifo}};
     std::vector<int> m_vec;
 };
 
@@ -202,6 +203,59 @@ TEST_F(EngineTest, ExecOneDetachTaskByEngine)
     ASSERT_EQ(m_vec[0], 1);
 }
 
+// 测试在工作线程上通过submit_next提交的任务优先于任务队列执行, 被挤出next slot的任务转入队列尾部
+TEST_F(EngineTest, SubmitNextTaskToEngine)
+{
+    auto t1 = func(m_vec, 1);
+    auto t2 = func(m_vec, 2);
+    auto t3 = func(m_vec, 3);
+    m_engine.submit_task(t1.handle());
+    m_engine.submit_next(t2.handle());
+    m_engine.submit_next(t3.handle());
+    t1.detach();
+    t2.detach();
+    t3.detach();
+
+    ASSERT_TRUE(m_engine.ready());
+    ASSERT_EQ(m_engine.num_task_schedule(), 2);
+
+    while (m_engine.ready())
+    {
+        m_engine.exec_one_task();
+    }
+
+    ASSERT_EQ(m_vec, std::vector<int>({1, 3, 2}));
+}
+
+// 测试高优先级的任务先于低优先级的任务执行, 同一优先级内保持提交顺序
+TEST_F(EngineTest, SubmitPriorityTaskToEngine)
+{
+    auto t1 = func(m_vec, 1);
+    auto t2 = func(m_vec, 2);
+    auto t3 = func(m_vec, 3);
+    auto t4 = func(m_vec, 4);
+    m_engine.submit_task(t1.handle(), detail::task_priority::low);
+    m_engine.submit_task(t2.handle());
+    m_engine.submit_task(t3.handle(), detail::task_priority::high);
+    m_engine.submit_task(t4.handle(), detail::task_priority::high);
+    t1.detach();
+    t2.detach();
+    t3.detach();
+    t4.detach();
+
+    ASSERT_EQ(m_engine.num_task_schedule(), 4);
+    ASSERT_EQ(m_engine.num_task_schedule(detail::task_priority::high), 2);
+    ASSERT_EQ(m_engine.num_task_schedule(detail::task_priority::normal), 1);
+    ASSERT_EQ(m_engine.num_task_schedule(detail::task_priority::low), 1);
+
+    while (m_engine.ready())
+    {
+        m_engine.exec_one_task();
+    }
+
+    ASSERT_EQ(m_vec, std::vector<int>({3, 4, 2, 1}));
+}
+
 //TODO: 添加更多engine测试文件
 
 
@@ -235,6 +289,35 @@ TEST_P(EngineNopIOTest, AddBatchNopIO)
     }
 }
 
+// 测试不阻塞的poll_ready可以收割全部nop-io
+TEST_P(EngineNopIOTest, PollReadyNopIO)
+{
+    int task_num = GetParam();
+    m_infos.resize(task_num);
+    m_vec = std::vector<int>(task_num,1);
+    for (int i = 0; i < task_num; i++)
+    {
+        m_infos[i].data = reinterpret_cast<uintptr_t>(&m_vec[i]);
+        m_infos[i].cb   = io_cb;
+        auto sqe        = m_engine.get_free_urs();
+        ASSERT_NE(sqe,nullptr);
+        io_uring_prep_nop(sqe);
+        io_uring_sqe_set_data(sqe, &m_infos[i]);
+        m_engine.add_io_submit();
+    }
+
+    do
+    {
+        m_engine.poll_ready();
+
+    } while (!m_engine.empty_io());
+
+    for (int i = 0; i < task_num; i++)
+    {
+        ASSERT_EQ(m_vec[i],0);
+    }
+}
+
 INSTANTIATE_TEST_SUITE_P(EngineNopIOTests, EngineNopIOTest, ::testing::Values(1, 100, 10000));
 
 
@@ -264,6 +347,79 @@ TEST_F(EngineTest, LoopAddNopIO)
     }
 }
 
+// 测试io_uring在第一次获取SQE时才创建, 只执行任务时不创建
+TEST(EngineRingTest, LazyRing)
+{
+    detail::engine   engine(engine_options{.lazy_ring = true});
+    std::vector<int> vec;
+    engine.init();
+    ASSERT_FALSE(engine.ring_ready());
+
+    auto task = func(vec, 1);
+    engine.submit_task(task.handle());
+    task.detach();
+    engine.exec_one_task();
+    engine.poll_ready();
+    ASSERT_EQ(vec, std::vector<int>({1}));
+    ASSERT_FALSE(engine.ring_ready());
+
+    vec.push_back(1);
+    io_info info;
+    info.data = reinterpret_cast<uintptr_t>(&vec[1]);
+    info.cb   = io_cb;
+    auto sqe  = engine.get_free_urs();
+    ASSERT_NE(sqe, nullptr);
+    ASSERT_TRUE(engine.ring_ready());
+    io_uring_prep_nop(sqe);
+    io_uring_sqe_set_data(sqe, &info);
+    engine.add_io_submit();
+    do
+    {
+        engine.poll_submit();
+    } while (!engine.empty_io());
+    ASSERT_EQ(vec[1], 0);
+
+    engine.deinit();
+    ASSERT_FALSE(engine.ring_ready());
+}
+
+// 测试关闭lazy_ring时init立即创建io_uring
+TEST(EngineRingTest, EagerRing)
+{
+    detail::engine engine(engine_options{.lazy_ring = false});
+    engine.init();
+    ASSERT_TRUE(engine.ring_ready());
+    engine.deinit();
+}
+
+// 测试SQ写满时get_free_urs先提交已有的SQE, 不会返回nullptr
+TEST(EngineRingTest, FullSubmitQueue)
+{
+    const int entry_length = 8;
+    const int io_num       = 10 * entry_length;
+
+    detail::engine       engine(engine_options{.entry_length = entry_length});
+    std::vector<int>     vec(io_num, 1);
+    std::vector<io_info> infos(io_num);
+    engine.init();
+    for (int i = 0; i < io_num; i++)
+    {
+        infos[i].data = reinterpret_cast<uintptr_t>(&vec[i]);
+        infos[i].cb   = io_cb;
+        auto sqe      = engine.get_free_urs();
+        ASSERT_NE(sqe, nullptr);
+        io_uring_prep_nop(sqe);
+        io_uring_sqe_set_data(sqe, &infos[i]);
+        engine.add_io_submit();
+    }
+    do
+    {
+        engine.poll_submit();
+    } while (!engine.empty_io());
+    ASSERT_EQ(vec, std::vector<int>(io_num, 0));
+    engine.deinit();
+}
+
 // 测试在开启引擎轮询之后继续添加task
 TEST_F(EngineTest, LastSubmitTaskToEngine)
 {
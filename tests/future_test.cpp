@@ -0,0 +1,189 @@
+#include <atomic>
+#include <memory>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "coro/coro.hpp"
+#include "coro/comp/event.hpp"
+#include "coro/future.hpp"
+#include "coro/io/io_awaiter.hpp"
+#include "gtest/gtest.h"
+
+using namespace coro;
+
+/*************************************************************
+ *                       pre-definition                      *
+ *************************************************************/
+
+int main(int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
+
+class FutureTest : public ::testing::TestWithParam<int>
+{
+};
+
+task<int> add_func(int a, int b)
+{
+    co_return a + b;
+}
+
+task<std::unique_ptr<std::string>> make_string_func(std::string str)
+{
+    co_return std::make_unique<std::string>(std::move(str));
+}
+
+task<> throw_func()
+{
+    throw std::runtime_error("future test");
+    co_return;
+}
+
+task<> spawn_and_await_func(int num, int& sum)
+{
+    std::vector<future<int>> futs;
+    for (int i = 0; i < num; i++)
+    {
+        futs.push_back(scheduler::spawn(add_func(i, 1)));
+    }
+    for (auto& fut : futs)
+    {
+        auto val = co_await fut;
+        sum += val;
+    }
+}
+
+task<int> noop_add_func(int a, int b)
+{
+    auto res = co_await io::noop_awaiter{};
+    co_return res + a + b;
+}
+
+task<> hold_func(event<>& ev)
+{
+    co_await ev.wait();
+}
+
+/*************************************************************
+ *                          tests                            *
+ *************************************************************/
+
+TEST_P(FutureTest, SyncWaitValue)
+{
+    scheduler::init(GetParam());
+    ASSERT_EQ(sync_wait(add_func(1, 2)), 3);
+}
+
+TEST_P(FutureTest, SyncWaitMoveOnly)
+{
+    scheduler::init(GetParam());
+    auto str = sync_wait(make_string_func("sheepcoro"));
+    ASSERT_NE(str, nullptr);
+    ASSERT_EQ(*str, "sheepcoro");
+}
+
+TEST_P(FutureTest, SyncWaitException)
+{
+    scheduler::init(GetParam());
+    ASSERT_THROW(sync_wait(throw_func()), std::runtime_error);
+}
+
+TEST_P(FutureTest, SyncWaitRepeatedly)
+{
+    scheduler::init(GetParam());
+    for (int i = 0; i < 3; i++)
+    {
+        ASSERT_EQ(sync_wait(add_func(i, 1)), i + 1);
+        ASSERT_EQ(sync_wait(noop_add_func(i, 2)), i + 2);
+        ASSERT_FALSE(scheduler::is_running());
+    }
+
+    // loop返回后提交的任务在下一次loop中执行
+    auto fut = scheduler::spawn(add_func(3, 4));
+    scheduler::loop();
+    ASSERT_EQ(fut.get(), 7);
+}
+
+TEST_P(FutureTest, SyncWaitRepeatedlyOnInstance)
+{
+    scheduler sched(scheduler_options{.ctx_cnt = static_cast<size_t>(GetParam())});
+    for (int i = 0; i < 3; i++)
+    {
+        ASSERT_EQ(sync_wait(sched, noop_add_func(i, 1)), i + 1);
+        ASSERT_EQ(sync_wait(sched, add_func(i, 2)), i + 2);
+        ASSERT_FALSE(sched.running());
+    }
+}
+
+TEST_P(FutureTest, SpawnAndAwait)
+{
+    constexpr int kNum = 1000;
+    int           sum  = 0;
+
+    scheduler::init(GetParam());
+    sync_wait(spawn_and_await_func(kNum, sum));
+
+    // sum(i + 1) for i in [0, kNum)
+    ASSERT_EQ(sum, kNum * (kNum + 1) / 2);
+}
+
+TEST_P(FutureTest, BlockOnForeignThread)
+{
+    constexpr int kNum = 100;
+    event<>       ev;
+
+    scheduler::init(GetParam());
+    // 保持scheduler运行直到所有结果都取回
+    submit_to_scheduler(hold_func(ev));
+    std::thread loop_thread([]() { scheduler::loop(); });
+
+    std::vector<future<int>> futs;
+    for (int i = 0; i < kNum; i++)
+    {
+        futs.push_back(scheduler::spawn(add_func(i, i)));
+    }
+    for (int i = 0; i < kNum; i++)
+    {
+        ASSERT_EQ(futs[i].get(), 2 * i);
+    }
+
+    ev.set();
+    loop_thread.join();
+    ASSERT_FALSE(scheduler::is_running());
+}
+
+TEST_P(FutureTest, SyncWaitOnForeignThreads)
+{
+    constexpr int kThreadNum = 4;
+    constexpr int kNum       = 200;
+    std::atomic<int> sum{0};
+
+    scheduler::init(GetParam());
+    // 没有任务保持scheduler运行, 各线程的sync_wait可能在其他线程的loop结束时提交
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreadNum; t++)
+    {
+        threads.emplace_back(
+            [&sum]()
+            {
+                for (int i = 0; i < kNum; i++)
+                {
+                    sum.fetch_add(sync_wait(add_func(i, 1)), std::memory_order_relaxed);
+                }
+            });
+    }
+    for (auto& t : threads)
+    {
+        t.join();
+    }
+
+    ASSERT_EQ(sum.load(), kThreadNum * kNum * (kNum + 1) / 2);
+    ASSERT_FALSE(scheduler::is_running());
+}
+
+INSTANTIATE_TEST_SUITE_P(FutureTests, FutureTest, ::testing::Values(1, 0, 4));
@@ -0,0 +1,231 @@
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <tuple>
+#include <vector>
+
+#include "coro/async_generator.hpp"
+#include "coro/comp/channel.hpp"
+#include "coro/coro.hpp"
+#include "coro/generator.hpp"
+#include "gtest/gtest.h"
+
+using namespace coro;
+
+/*************************************************************
+ *                       pre-definition                      *
+ *************************************************************/
+
+int main(int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
+
+class AsyncGeneratorTest : public ::testing::TestWithParam<std::tuple<int, int>>
+{
+};
+
+/**
+ * @brief 记录复制次数, 用于验证yield不会复制元素
+ */
+struct copy_counter
+{
+    explicit copy_counter(int v, int& copies) noexcept : val(v), cnt(&copies) {}
+    copy_counter(const copy_counter& other) noexcept : val(other.val), cnt(other.cnt) { ++(*cnt); }
+    copy_counter& operator=(const copy_counter&) = delete;
+
+    int  val;
+    int* cnt;
+};
+
+generator<int> iota_gen(int num)
+{
+    for (int i = 0; i < num; i++)
+    {
+        co_yield i;
+    }
+}
+
+generator<const copy_counter&> counter_gen(int num, int& copies)
+{
+    for (int i = 0; i < num; i++)
+    {
+        copy_counter c(i, copies);
+        co_yield c;
+    }
+}
+
+generator<std::unique_ptr<int>> move_only_gen(int num)
+{
+    for (int i = 0; i < num; i++)
+    {
+        co_yield std::make_unique<int>(i);
+    }
+}
+
+generator<int> throw_gen()
+{
+    co_yield 1;
+    throw std::runtime_error("generator test");
+}
+
+/**
+ * @brief 每个元素都需要挂起等待channel, 由另一个context上的协程发送
+ */
+async_generator<int> recv_gen(channel<int>& ch)
+{
+    while (true)
+    {
+        auto val = co_await ch.recv();
+        if (!val.has_value())
+        {
+            co_return;
+        }
+        co_yield *val;
+    }
+}
+
+async_generator<int> async_throw_gen()
+{
+    co_yield 1;
+    throw std::runtime_error("async generator test");
+}
+
+task<> send_func(channel<int>& ch, int num)
+{
+    for (int i = 1; i <= num; i++)
+    {
+        co_await ch.send(i);
+    }
+    ch.close();
+}
+
+task<> consume_func(channel<int>& ch, long& sum, int& cnt)
+{
+    auto gen = recv_gen(ch);
+    auto it  = co_await gen.begin();
+    while (it != gen.end())
+    {
+        sum += *it;
+        cnt++;
+        co_await ++it;
+    }
+}
+
+task<> async_throw_func(int& first, bool& caught)
+{
+    auto gen = async_throw_gen();
+    try
+    {
+        auto it = co_await gen.begin();
+        first   = *it;
+        co_await ++it;
+    }
+    catch (const std::runtime_error&)
+    {
+        caught = true;
+    }
+}
+
+/*************************************************************
+ *                          tests                            *
+ *************************************************************/
+
+TEST(GeneratorTest, Iota)
+{
+    std::vector<int> vec;
+    for (auto v : iota_gen(100))
+    {
+        vec.push_back(v);
+    }
+    ASSERT_EQ(vec.size(), 100);
+    for (int i = 0; i < 100; i++)
+    {
+        ASSERT_EQ(vec[i], i);
+    }
+}
+
+TEST(GeneratorTest, Empty)
+{
+    int num = 0;
+    for ([[maybe_unused]] auto v : iota_gen(0))
+    {
+        num++;
+    }
+    ASSERT_EQ(num, 0);
+}
+
+TEST(GeneratorTest, NoCopy)
+{
+    int copies = 0;
+    int sum    = 0;
+    for (const auto& c : counter_gen(100, copies))
+    {
+        sum += c.val;
+    }
+    ASSERT_EQ(sum, 99 * 100 / 2);
+    ASSERT_EQ(copies, 0);
+}
+
+TEST(GeneratorTest, MoveOnly)
+{
+    std::vector<std::unique_ptr<int>> vec;
+    for (auto& p : move_only_gen(10))
+    {
+        vec.push_back(std::move(p));
+    }
+    ASSERT_EQ(vec.size(), 10);
+    for (int i = 0; i < 10; i++)
+    {
+        ASSERT_EQ(*vec[i], i);
+    }
+}
+
+TEST(GeneratorTest, Exception)
+{
+    auto gen = throw_gen();
+    auto it  = gen.begin();
+    ASSERT_EQ(*it, 1);
+    ASSERT_THROW(++it, std::runtime_error);
+}
+
+TEST_P(AsyncGeneratorTest, RecvFromOtherContext)
+{
+    int thread_num, num;
+    std::tie(thread_num, num) = GetParam();
+
+    channel<int> ch(0);
+    long         sum = 0;
+    int          cnt = 0;
+
+    scheduler::init(thread_num);
+    scheduler::submit(consume_func(ch, sum, cnt), 0);
+    scheduler::submit(send_func(ch, num), scheduler::context_count() - 1);
+    scheduler::loop();
+
+    ASSERT_EQ(cnt, num);
+    ASSERT_EQ(sum, static_cast<long>(num) * (num + 1) / 2);
+}
+
+TEST_P(AsyncGeneratorTest, Exception)
+{
+    int  first  = 0;
+    bool caught = false;
+
+    scheduler::init(std::get<0>(GetParam()));
+    sync_wait(async_throw_func(first, caught));
+
+    ASSERT_EQ(first, 1);
+    ASSERT_TRUE(caught);
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    AsyncGeneratorTests,
+    AsyncGeneratorTest,
+    ::testing::Values(
+        std::make_tuple(1, 0),
+        std::make_tuple(1, 100),
+        std::make_tuple(0, 100),
+        std::make_tuple(2, 10000),
+        std::make_tuple(4, 10000)));
@@ -0,0 +1,174 @@
+#include <atomic>
+#include <tuple>
+#include <vector>
+
+#include "coro/coro.hpp"
+#include "coro/comp/event.hpp"
+#include "coro/comp/mutex.hpp"
+#include "gtest/gtest.h"
+
+using namespace coro;
+
+/*************************************************************
+ *                       pre-definition                      *
+ *************************************************************/
+
+int main(int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
+
+class MutexTest : public ::testing::TestWithParam<std::tuple<int, int>>
+{
+protected:
+    void SetUp() override
+    {
+        m_count   = 0;
+        m_overlap = 0;
+        m_inside  = 0;
+    }
+
+    mutex            m_mtx;
+    int              m_count;   // 只在临界区内修改
+    std::atomic<int> m_inside;  // 同时处于临界区内的协程数
+    std::atomic<int> m_overlap; // 检测到临界区重叠的次数
+};
+
+class MutexOrderTest : public ::testing::Test
+{
+protected:
+    mutex            m_mtx;
+    event<>          m_ev;
+    std::vector<int> m_vec;
+};
+
+task<> lock_func(mutex& mtx, int& count, std::atomic<int>& inside, std::atomic<int>& overlap, int loop)
+{
+    for (int i = 0; i < loop; i++)
+    {
+        co_await mtx.lock();
+        if (inside.fetch_add(1, std::memory_order_acq_rel) != 0)
+        {
+            overlap.fetch_add(1, std::memory_order_relaxed);
+        }
+        count++;
+        inside.fetch_sub(1, std::memory_order_acq_rel);
+        mtx.unlock();
+    }
+}
+
+task<> scoped_lock_func(mutex& mtx, int& count, std::atomic<int>& inside, std::atomic<int>& overlap, int loop)
+{
+    for (int i = 0; i < loop; i++)
+    {
+        auto guard = co_await mtx.scoped_lock();
+        if (inside.fetch_add(1, std::memory_order_acq_rel) != 0)
+        {
+            overlap.fetch_add(1, std::memory_order_relaxed);
+        }
+        count++;
+        inside.fetch_sub(1, std::memory_order_acq_rel);
+    }
+}
+
+// 持锁后等待event, 使后续的协程全部进入等待队列
+task<> hold_func(mutex& mtx, event<>& ev, std::vector<int>& vec)
+{
+    co_await mtx.lock();
+    co_await ev.wait();
+    vec.push_back(-1);
+    mtx.unlock();
+}
+
+task<> order_func(mutex& mtx, std::vector<int>& vec, int id)
+{
+    auto guard = co_await mtx.scoped_lock();
+    vec.push_back(id);
+}
+
+task<> release_func(event<>& ev)
+{
+    ev.set();
+    co_return;
+}
+
+/*************************************************************
+ *                          tests                            *
+ *************************************************************/
+
+TEST(MutexBaseTest, TryLock)
+{
+    mutex mtx;
+    ASSERT_TRUE(mtx.try_lock());
+    ASSERT_FALSE(mtx.try_lock());
+    mtx.unlock();
+    ASSERT_TRUE(mtx.try_lock());
+    mtx.unlock();
+}
+
+TEST_P(MutexTest, LockAndUnlock)
+{
+    int thread_num, task_num;
+    std::tie(thread_num, task_num) = GetParam();
+
+    scheduler::init(thread_num);
+    for (int i = 0; i < task_num; i++)
+    {
+        submit_to_scheduler(lock_func(m_mtx, m_count, m_inside, m_overlap, 10));
+    }
+    scheduler::loop();
+
+    ASSERT_EQ(m_overlap.load(), 0);
+    ASSERT_EQ(m_count, task_num * 10);
+    ASSERT_TRUE(m_mtx.try_lock());
+}
+
+TEST_P(MutexTest, ScopedLock)
+{
+    int thread_num, task_num;
+    std::tie(thread_num, task_num) = GetParam();
+
+    scheduler::init(thread_num);
+    for (int i = 0; i < task_num; i++)
+    {
+        submit_to_scheduler(scoped_lock_func(m_mtx, m_count, m_inside, m_overlap, 10));
+    }
+    scheduler::loop();
+
+    ASSERT_EQ(m_overlap.load(), 0);
+    ASSERT_EQ(m_count, task_num * 10);
+    ASSERT_TRUE(m_mtx.try_lock());
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    MutexTests,
+    MutexTest,
+    ::testing::Values(
+        std::make_tuple(1, 1),
+        std::make_tuple(1, 100),
+        std::make_tuple(0, 1),
+        std::make_tuple(0, 100),
+        std::make_tuple(0, 1000),
+        std::make_tuple(4, 1000)));
+
+TEST_F(MutexOrderTest, FifoHandoff)
+{
+    constexpr int kWaiterNum = 100;
+
+    scheduler::init(1);
+    submit_to_scheduler(hold_func(m_mtx, m_ev, m_vec));
+    for (int i = 0; i < kWaiterNum; i++)
+    {
+        submit_to_scheduler(order_func(m_mtx, m_vec, i));
+    }
+    submit_to_scheduler(release_func(m_ev));
+    scheduler::loop();
+
+    ASSERT_EQ(m_vec.size(), kWaiterNum + 1);
+    ASSERT_EQ(m_vec[0], -1);
+    for (int i = 0; i < kWaiterNum; i++)
+    {
+        ASSERT_EQ(m_vec[i + 1], i);
+    }
+}
@@ -0,0 +1,191 @@
+#include <arpa/inet.h>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <mutex>
+#include <poll.h>
+#include <set>
+#include <stop_token>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+#include "coro/coro.hpp"
+#include "coro/io/net/tcp/tcp.hpp"
+#include "gtest/gtest.h"
+
+using namespace coro;
+using io::net::tcp::tcp_client;
+using io::net::tcp::tcp_connector;
+using io::net::tcp::tcp_server;
+using io::net::tcp::serve_sharded;
+
+/*************************************************************
+ *                       pre-definition                      *
+ *************************************************************/
+
+int main(int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
+
+class TcpReusePortTest : public ::testing::Test
+{
+protected:
+    static constexpr int kPort = 8102;
+
+    std::vector<int> m_vec;
+};
+
+// 返回poll到可读的listener下标, 内核按四元组哈希选择其中一个
+auto readable_index(const std::vector<int>& fds) -> int
+{
+    std::vector<pollfd> pfds;
+    for (auto fd : fds)
+    {
+        pfds.push_back(pollfd{.fd = fd, .events = POLLIN, .revents = 0});
+    }
+    if (::poll(pfds.data(), pfds.size(), 1000) <= 0)
+    {
+        return -1;
+    }
+    for (size_t i = 0; i < pfds.size(); i++)
+    {
+        if (pfds[i].revents & POLLIN)
+        {
+            return static_cast<int>(i);
+        }
+    }
+    return -1;
+}
+
+task<> reuse_port_func(int port, std::vector<int>& vec)
+{
+    // 未开启SO_REUSEPORT时第二个socket会bind失败
+    auto             server1 = tcp_server("127.0.0.1", port, 64, true);
+    auto             server2 = tcp_server("127.0.0.1", port, 64, true);
+    auto             client  = tcp_client("127.0.0.1", port);
+    tcp_server*      servers[2] = {&server1, &server2};
+    std::vector<int> listenfds;
+
+    int clientfd = co_await client.connect();
+    vec.push_back(clientfd > 0);
+
+    // 只有被内核选中的listener上有待accept的连接
+    listenfds.push_back(server1.fd());
+    listenfds.push_back(server2.fd());
+    int idx = readable_index(listenfds);
+    vec.push_back(idx >= 0);
+    if (idx < 0)
+    {
+        co_return;
+    }
+
+    int serverfd = co_await servers[idx]->accept();
+    vec.push_back(serverfd > 0);
+
+    auto cli = tcp_connector(clientfd);
+    auto svr = tcp_connector(serverfd);
+
+    char msg[]   = "reuse port";
+    char buf[32] = {0};
+    vec.push_back(co_await cli.write(msg, sizeof(msg)));
+    vec.push_back(co_await svr.read(buf, sizeof(buf)));
+    vec.push_back(strcmp(buf, msg));
+
+    co_await cli.close();
+    co_await svr.close();
+}
+
+/**
+ * @brief 记录accept连接的context并关闭连接
+ */
+task<> record_func(int fd, std::mutex& mtx, std::set<size_t>& ctxs, std::atomic<int>& handled)
+{
+    {
+        std::lock_guard<std::mutex> lk(mtx);
+        ctxs.insert(local_context().get_ctx_id());
+    }
+    co_await tcp_connector(fd).close();
+    handled.fetch_add(1, std::memory_order_acq_rel);
+}
+
+// 以阻塞的系统调用连接, listener尚未bind时重试
+auto blocking_connect(int port) -> bool
+{
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port   = htons(port);
+    inet_pton(AF_INET, "127.0.0.1", &addr.sin_addr);
+    for (int retry = 0; retry < 100; retry++)
+    {
+        int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+        if (::connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == 0)
+        {
+            ::close(fd);
+            return true;
+        }
+        ::close(fd);
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    return false;
+}
+
+/*************************************************************
+ *                          tests                            *
+ *************************************************************/
+
+TEST_F(TcpReusePortTest, ListenersShareOnePort)
+{
+    scheduler::init(1);
+    submit_to_scheduler(reuse_port_func(kPort, m_vec));
+    scheduler::loop();
+
+    ASSERT_EQ(m_vec.size(), 6);
+    ASSERT_EQ(m_vec[0], 1);
+    ASSERT_EQ(m_vec[1], 1);
+    ASSERT_EQ(m_vec[2], 1);
+    ASSERT_EQ(m_vec[3], sizeof("reuse port"));
+    ASSERT_EQ(m_vec[4], sizeof("reuse port"));
+    ASSERT_EQ(m_vec[5], 0);
+}
+
+// 测试serve_sharded在每个context上accept连接, 连接分散到多个context, 请求停止后scheduler可以结束
+TEST_F(TcpReusePortTest, ServeShardedAcrossContexts)
+{
+    constexpr int    kCtxNum  = 4;
+    constexpr int    kConnNum = 64;
+    std::mutex       mtx;
+    std::set<size_t> ctxs;
+    std::atomic<int> handled{0};
+    std::stop_source stop;
+
+    scheduler::init(kCtxNum);
+    serve_sharded(
+        "127.0.0.1",
+        kPort + 1,
+        [&](int fd) { return record_func(fd, mtx, ctxs, handled); },
+        stop.get_token());
+    std::thread loop_thread([]() { scheduler::loop(); });
+
+    // 等待全部listener完成bind, 之后的连接才会按四元组哈希分散到各个listener
+    int connected = blocking_connect(kPort + 1) ? 1 : 0;
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    for (int i = 1; i < kConnNum; i++)
+    {
+        connected += blocking_connect(kPort + 1) ? 1 : 0;
+    }
+    while (handled.load(std::memory_order_acquire) < connected)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    stop.request_stop();
+    loop_thread.join();
+
+    ASSERT_EQ(connected, kConnNum);
+    ASSERT_FALSE(scheduler::is_running());
+    ASSERT_GT(ctxs.size(), 1);
+}
@@ -0,0 +1,244 @@
+#include <arpa/inet.h>
+#include <cerrno>
+#include <cstring>
+#include <netinet/in.h>
+#include <string>
+#include <vector>
+
+#include "coro/coro.hpp"
+#include "coro/io/net/udp/udp.hpp"
+#include "gtest/gtest.h"
+
+using namespace coro;
+using io::net::socket_address;
+using io::net::udp::udp_datagram;
+using io::net::udp::udp_receiver;
+using io::net::udp::udp_socket;
+
+/*************************************************************
+ *                       pre-definition                      *
+ *************************************************************/
+
+int main(int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
+
+class UdpTest : public ::testing::Test
+{
+protected:
+    void SetUp() override { m_dst = socket_address::ipv4("127.0.0.1", kPort); }
+
+    static constexpr int kPort = 8101;
+
+    socket_address   m_dst;
+    std::vector<int> m_vec;
+};
+
+task<> send_recv_func(socket_address dst, std::vector<int>& vec)
+{
+    auto server = udp_socket(dst);
+    auto client = udp_socket(dst.family());
+
+    char msg[] = "hello udp";
+    vec.push_back(co_await client.send_to(msg, sizeof(msg), dst));
+
+    char           buf[64] = {0};
+    socket_address src;
+    vec.push_back(co_await server.recv_from(buf, sizeof(buf), &src));
+    vec.push_back(strcmp(buf, msg));
+    vec.push_back(src.family());
+
+    vec.push_back(co_await client.close());
+    vec.push_back(co_await server.close());
+}
+
+task<> gso_func(socket_address dst, std::vector<int>& vec)
+{
+    auto server = udp_socket(dst);
+    auto client = udp_socket(dst.family());
+
+    std::string data(250, 'x');
+    vec.push_back(co_await client.send_segments(data.data(), data.size(), 100, dst));
+
+    char buf[256];
+    for (int i = 0; i < 3; i++)
+    {
+        vec.push_back(co_await server.recv_from(buf, sizeof(buf)));
+    }
+
+    co_await client.close();
+    co_await server.close();
+}
+
+auto push_datagram(std::vector<int>& vec, const udp_datagram& dg, const char* expect) -> void
+{
+    vec.push_back(dg.len);
+    if (dg.ok())
+    {
+        vec.push_back(strcmp(dg.data, expect));
+        vec.push_back(dg.src.family());
+    }
+}
+
+task<> receiver_func(socket_address dst, std::vector<int>& vec)
+{
+    auto         server = udp_socket(dst);
+    auto         client = udp_socket(dst.family());
+    udp_receiver rx(server, 4, 256);
+
+    const char* msgs[] = {"first", "second", "third"};
+    for (auto msg : msgs)
+    {
+        co_await client.send_to(msg, strlen(msg) + 1, dst);
+    }
+
+    // 第一次recv提交multishot请求, 之后的datagram由同一个请求持续产生
+    for (auto msg : msgs)
+    {
+        auto dg = co_await rx.recv();
+        push_datagram(vec, dg, msg);
+        rx.recycle(dg);
+    }
+    co_await rx.stop();
+
+    co_await client.close();
+    co_await server.close();
+}
+
+task<> exhaust_func(socket_address dst, std::vector<int>& vec)
+{
+    auto         server = udp_socket(dst);
+    auto         client = udp_socket(dst.family());
+    udp_receiver rx(server, 2, 256);
+
+    const char* msgs[] = {"0", "1", "2", "3"};
+    for (auto msg : msgs)
+    {
+        co_await client.send_to(msg, strlen(msg) + 1, dst);
+    }
+
+    // 两个buffer都未归还, 第三个datagram到达时内核以-ENOBUFS终止multishot请求
+    auto dg0 = co_await rx.recv();
+    push_datagram(vec, dg0, msgs[0]);
+    auto dg1 = co_await rx.recv();
+    push_datagram(vec, dg1, msgs[1]);
+    auto nobuf = co_await rx.recv();
+    vec.push_back(nobuf.len);
+    vec.push_back(nobuf.bid);
+
+    // 归还buffer后下一次recv重新提交请求, 剩余的datagram没有丢失
+    rx.recycle(dg0);
+    rx.recycle(dg1);
+    for (int i = 2; i < 4; i++)
+    {
+        auto dg = co_await rx.recv();
+        push_datagram(vec, dg, msgs[i]);
+        rx.recycle(dg);
+    }
+    co_await rx.stop();
+
+    co_await client.close();
+    co_await server.close();
+}
+
+task<> pending_recv_func(udp_receiver& rx, std::vector<int>& vec)
+{
+    auto dg = co_await rx.recv();
+    vec.push_back(dg.len);
+}
+
+task<> cancel_receiver_func(socket_address dst, std::vector<int>& vec)
+{
+    auto         server = udp_socket(dst);
+    udp_receiver rx(server);
+    task_group   group;
+
+    // 接收者先挂起并提交multishot请求, 之后stop取消该请求
+    group.spawn(pending_recv_func(rx, vec), local_context().get_index());
+    co_await yield();
+    co_await rx.stop();
+    co_await group.wait();
+
+    // 已经停止的接收器再次stop直接返回
+    co_await rx.stop();
+    vec.push_back(0);
+
+    co_await server.close();
+}
+
+/*************************************************************
+ *                          tests                            *
+ *************************************************************/
+
+TEST_F(UdpTest, SendToAndRecvFrom)
+{
+    scheduler::init(1);
+    submit_to_scheduler(send_recv_func(m_dst, m_vec));
+    scheduler::loop();
+
+    ASSERT_EQ(m_vec.size(), 6);
+    ASSERT_EQ(m_vec[0], sizeof("hello udp"));
+    ASSERT_EQ(m_vec[1], sizeof("hello udp"));
+    ASSERT_EQ(m_vec[2], 0);
+    ASSERT_EQ(m_vec[3], AF_INET);
+    ASSERT_EQ(m_vec[4], 0);
+    ASSERT_EQ(m_vec[5], 0);
+}
+
+TEST_F(UdpTest, SendToAndRecvFromIPv6)
+{
+    m_dst = socket_address::ipv6("::1", kPort);
+    scheduler::init(1);
+    submit_to_scheduler(send_recv_func(m_dst, m_vec));
+    scheduler::loop();
+
+    ASSERT_EQ(m_vec.size(), 6);
+    ASSERT_EQ(m_vec[0], sizeof("hello udp"));
+    ASSERT_EQ(m_vec[1], sizeof("hello udp"));
+    ASSERT_EQ(m_vec[2], 0);
+    ASSERT_EQ(m_vec[3], AF_INET6);
+    ASSERT_EQ(m_vec[4], 0);
+    ASSERT_EQ(m_vec[5], 0);
+}
+
+TEST_F(UdpTest, SendSegmentsByGSO)
+{
+    scheduler::init(1);
+    submit_to_scheduler(gso_func(m_dst, m_vec));
+    scheduler::loop();
+
+    ASSERT_EQ(m_vec.size(), 4);
+    ASSERT_EQ(m_vec[0], 250);
+    ASSERT_EQ(m_vec[1], 100);
+    ASSERT_EQ(m_vec[2], 100);
+    ASSERT_EQ(m_vec[3], 50);
+}
+
+TEST_F(UdpTest, ReceiverArmRecvStop)
+{
+    scheduler::init(1);
+    submit_to_scheduler(receiver_func(m_dst, m_vec));
+    scheduler::loop();
+
+    ASSERT_EQ(m_vec, std::vector<int>({6, 0, AF_INET, 7, 0, AF_INET, 6, 0, AF_INET}));
+}
+
+TEST_F(UdpTest, ReceiverRearmAfterBufferExhaustion)
+{
+    scheduler::init(1);
+    submit_to_scheduler(exhaust_func(m_dst, m_vec));
+    scheduler::loop();
+
+    ASSERT_EQ(m_vec, std::vector<int>({2, 0, AF_INET, 2, 0, AF_INET, -ENOBUFS, -1, 2, 0, AF_INET, 2, 0, AF_INET}));
+}
+
+TEST_F(UdpTest, ReceiverCancelPendingRecv)
+{
+    scheduler::init(1);
+    submit_to_scheduler(cancel_receiver_func(m_dst, m_vec));
+    scheduler::loop();
+
+    ASSERT_EQ(m_vec, std::vector<int>({-ECANCELED, 0}));
+}
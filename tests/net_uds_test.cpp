@@ -0,0 +1,210 @@
+#include <cstring>
+#include <string>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <vector>
+
+#include "coro/coro.hpp"
+#include "coro/io/net/uds/uds.hpp"
+#include "gtest/gtest.h"
+
+using namespace coro;
+using io::net::socket_address;
+using io::net::uds::uds_client;
+using io::net::uds::uds_connector;
+using io::net::uds::uds_datagram;
+using io::net::uds::uds_server;
+
+/*************************************************************
+ *                       pre-definition                      *
+ *************************************************************/
+
+int main(int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
+
+class UdsTest : public ::testing::Test
+{
+protected:
+    void SetUp() override { m_path = "/tmp/coro_uds_test_" + std::to_string(::getpid()) + ".sock"; }
+
+    void TearDown() override { ::unlink(m_path.c_str()); }
+
+    std::string      m_path;
+    std::vector<int> m_vec;
+};
+
+task<> stream_func(const char* path, std::vector<int>& vec)
+{
+    auto server = uds_server(path);
+    auto client = uds_client(path);
+
+    // unix domain socket的connect在backlog未满时立即完成
+    int clientfd = co_await client.connect();
+    vec.push_back(clientfd > 0);
+    int serverfd = co_await server.accept();
+    vec.push_back(serverfd > 0);
+
+    auto cli = uds_connector(clientfd);
+    auto svr = uds_connector(serverfd);
+
+    char msg[]   = "hello uds";
+    char buf[64] = {0};
+    vec.push_back(co_await cli.write(msg, sizeof(msg)));
+    vec.push_back(co_await svr.read(buf, sizeof(buf)));
+    vec.push_back(strcmp(buf, msg));
+
+    vec.push_back(co_await cli.close());
+    vec.push_back(co_await svr.close());
+}
+
+task<> pass_fd_func(std::vector<int>& vec)
+{
+    int sv[2];
+    ::socketpair(AF_UNIX, SOCK_STREAM, 0, sv);
+    int pipefd[2];
+    ::pipe(pipefd);
+
+    auto sender   = uds_connector(sv[0]);
+    auto receiver = uds_connector(sv[1]);
+
+    char tag = 'f';
+    vec.push_back(co_await sender.send_fds(&tag, 1, &pipefd[1], 1));
+
+    char   buf    = 0;
+    int    fds[2] = {-1, -1};
+    size_t nfds   = 0;
+    vec.push_back(co_await receiver.recv_fds(&buf, 1, fds, 2, &nfds));
+    vec.push_back(buf);
+    vec.push_back(nfds);
+
+    // 通过收到的描述符写入pipe, 从原始的读端读出
+    char msg[] = "via fd";
+    ::write(fds[0], msg, sizeof(msg));
+    char rbuf[16] = {0};
+    vec.push_back(::read(pipefd[0], rbuf, sizeof(rbuf)));
+    vec.push_back(strcmp(rbuf, msg));
+
+    ::close(fds[0]);
+    ::close(pipefd[0]);
+    ::close(pipefd[1]);
+    co_await sender.close();
+    co_await receiver.close();
+}
+
+task<> too_many_fds_func(std::vector<int>& vec)
+{
+    int sv[2];
+    ::socketpair(AF_UNIX, SOCK_STREAM, 0, sv);
+
+    // 超出上限的描述符数量不应写入控制消息缓冲区
+    std::vector<int> fds(config::kUdsMaxFds + 1, sv[0]);
+
+    auto sender = uds_connector(sv[0]);
+    char tag    = 'f';
+    vec.push_back(co_await sender.send_fds(&tag, 1, fds.data(), fds.size()));
+    // 上限以内仍然可以正常发送
+    vec.push_back(co_await sender.send_fds(&tag, 1, fds.data(), config::kUdsMaxFds));
+
+    co_await sender.close();
+    ::close(sv[1]);
+}
+
+task<> datagram_func(std::vector<int>& vec)
+{
+    std::string name = "@coro_uds_dgram_" + std::to_string(::getpid());
+    auto        server = uds_datagram(name.c_str());
+    auto        client = uds_datagram();
+
+    auto dst = socket_address::unix_path(name.c_str());
+
+    char msg[] = "hello dgram";
+    vec.push_back(co_await client.send_to(msg, sizeof(msg), dst));
+
+    char buf[64] = {0};
+    vec.push_back(co_await server.recv_from(buf, sizeof(buf)));
+    vec.push_back(strcmp(buf, msg));
+
+    vec.push_back(co_await client.close());
+    vec.push_back(co_await server.close());
+}
+
+/*************************************************************
+ *                          tests                            *
+ *************************************************************/
+
+TEST_F(UdsTest, StreamConnectReadWrite)
+{
+    scheduler::init(1);
+    submit_to_scheduler(stream_func(m_path.c_str(), m_vec));
+    scheduler::loop();
+
+    ASSERT_EQ(m_vec.size(), 7);
+    ASSERT_EQ(m_vec[0], 1);
+    ASSERT_EQ(m_vec[1], 1);
+    ASSERT_EQ(m_vec[2], sizeof("hello uds"));
+    ASSERT_EQ(m_vec[3], sizeof("hello uds"));
+    ASSERT_EQ(m_vec[4], 0);
+    ASSERT_EQ(m_vec[5], 0);
+    ASSERT_EQ(m_vec[6], 0);
+}
+
+// 已关闭的监听者留下的socket文件会被删除, 服务端可以重新绑定同一路径
+TEST_F(UdsTest, ReplaceStaleSocketFile)
+{
+    auto addr = socket_address::unix_path(m_path.c_str());
+    int  fd   = socket(AF_UNIX, SOCK_STREAM, 0);
+    ASSERT_GE(fd, 0);
+    ASSERT_EQ(bind(fd, addr.data(), addr.size()), 0);
+    ::close(fd);
+
+    scheduler::init(1);
+    submit_to_scheduler(stream_func(m_path.c_str(), m_vec));
+    scheduler::loop();
+
+    ASSERT_EQ(m_vec.size(), 7);
+    ASSERT_EQ(m_vec[2], sizeof("hello uds"));
+    ASSERT_EQ(m_vec[3], sizeof("hello uds"));
+}
+
+TEST_F(UdsTest, PassFdByScmRights)
+{
+    scheduler::init(1);
+    submit_to_scheduler(pass_fd_func(m_vec));
+    scheduler::loop();
+
+    ASSERT_EQ(m_vec.size(), 6);
+    ASSERT_EQ(m_vec[0], 1);
+    ASSERT_EQ(m_vec[1], 1);
+    ASSERT_EQ(m_vec[2], 'f');
+    ASSERT_EQ(m_vec[3], 1);
+    ASSERT_EQ(m_vec[4], sizeof("via fd"));
+    ASSERT_EQ(m_vec[5], 0);
+}
+
+TEST_F(UdsTest, RejectTooManyFds)
+{
+    scheduler::init(1);
+    submit_to_scheduler(too_many_fds_func(m_vec));
+    scheduler::loop();
+
+    ASSERT_EQ(m_vec.size(), 2);
+    ASSERT_EQ(m_vec[0], -EINVAL);
+    ASSERT_EQ(m_vec[1], 1);
+}
+
+TEST_F(UdsTest, DatagramSendToAndRecvFrom)
+{
+    scheduler::init(1);
+    submit_to_scheduler(datagram_func(m_vec));
+    scheduler::loop();
+
+    ASSERT_EQ(m_vec.size(), 5);
+    ASSERT_EQ(m_vec[0], sizeof("hello dgram"));
+    ASSERT_EQ(m_vec[1], sizeof("hello dgram"));
+    ASSERT_EQ(m_vec[2], 0);
+    ASSERT_EQ(m_vec[3], 0);
+    ASSERT_EQ(m_vec[4], 0);
+}
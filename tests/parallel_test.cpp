@@ -0,0 +1,220 @@
+#include <atomic>
+#include <cstdint>
+#include <numeric>
+#include <stdexcept>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+#include "coro/coro.hpp"
+#include "coro/parallel/parallel.hpp"
+#include "gtest/gtest.h"
+
+using namespace coro;
+
+/*************************************************************
+ *                       pre-definition                      *
+ *************************************************************/
+
+int main(int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
+
+class ParallelTest : public ::testing::TestWithParam<std::tuple<int, int, int>>
+{
+};
+
+task<> for_index_func(int num, int grain, std::vector<int>& vec)
+{
+    co_await parallel_for(0, num, grain, [&vec](int i) { vec[i] += i; });
+}
+
+task<> for_range_func(int grain, std::vector<int>& vec)
+{
+    co_await parallel_for(vec, grain, [](int& v) { v *= 2; });
+}
+
+task<> for_ctx_func(int num, int grain, std::vector<std::atomic<int>>& ctx_cnt, std::atomic<size_t>& seen)
+{
+    co_await parallel_for(
+        0,
+        num,
+        grain,
+        [&ctx_cnt, &seen](int)
+        {
+            if (ctx_cnt[local_context().get_index()].fetch_add(1, std::memory_order_relaxed) == 0)
+            {
+                seen.fetch_add(1, std::memory_order_acq_rel);
+            }
+            // 每个context领取到第一块后等待其余context也领取到, 验证worker确实分布在每个context上
+            while (seen.load(std::memory_order_acquire) < ctx_cnt.size())
+            {
+                std::this_thread::yield();
+            }
+        });
+}
+
+task<> reduce_index_func(int num, int grain, int64_t& sum)
+{
+    sum = co_await parallel_reduce(
+        0,
+        num,
+        grain,
+        int64_t{0},
+        [](int i) { return static_cast<int64_t>(i); },
+        [](int64_t a, int64_t b) { return a + b; });
+}
+
+task<> reduce_range_func(std::vector<int>& vec, int grain, int64_t& sum)
+{
+    sum = co_await parallel_reduce(
+        vec,
+        grain,
+        int64_t{0},
+        [](int v) { return static_cast<int64_t>(v) * v; },
+        [](int64_t a, int64_t b) { return a + b; });
+}
+
+task<> throw_func(int num, std::atomic<int>& cnt, bool& caught)
+{
+    try
+    {
+        co_await parallel_for(
+            0,
+            num,
+            1,
+            [&cnt](int i)
+            {
+                cnt.fetch_add(1, std::memory_order_relaxed);
+                if (i == 0)
+                {
+                    throw std::runtime_error("parallel test");
+                }
+            });
+    }
+    catch (const std::runtime_error&)
+    {
+        caught = true;
+    }
+}
+
+/*************************************************************
+ *                          tests                            *
+ *************************************************************/
+
+TEST_P(ParallelTest, ForIndex)
+{
+    int thread_num, num, grain;
+    std::tie(thread_num, num, grain) = GetParam();
+
+    std::vector<int> vec(num, 0);
+
+    scheduler::init(thread_num);
+    sync_wait(for_index_func(num, grain, vec));
+
+    for (int i = 0; i < num; i++)
+    {
+        ASSERT_EQ(vec[i], i);
+    }
+}
+
+TEST_P(ParallelTest, ForRange)
+{
+    int thread_num, num, grain;
+    std::tie(thread_num, num, grain) = GetParam();
+
+    std::vector<int> vec(num);
+    std::iota(vec.begin(), vec.end(), 0);
+
+    scheduler::init(thread_num);
+    sync_wait(for_range_func(grain, vec));
+
+    for (int i = 0; i < num; i++)
+    {
+        ASSERT_EQ(vec[i], 2 * i);
+    }
+}
+
+TEST_P(ParallelTest, ReduceIndex)
+{
+    int thread_num, num, grain;
+    std::tie(thread_num, num, grain) = GetParam();
+
+    int64_t sum = -1;
+
+    scheduler::init(thread_num);
+    sync_wait(reduce_index_func(num, grain, sum));
+
+    ASSERT_EQ(sum, static_cast<int64_t>(num) * (num - 1) / 2);
+}
+
+TEST_P(ParallelTest, ReduceRange)
+{
+    int thread_num, num, grain;
+    std::tie(thread_num, num, grain) = GetParam();
+
+    std::vector<int> vec(num);
+    std::iota(vec.begin(), vec.end(), 0);
+    int64_t sum = -1;
+
+    scheduler::init(thread_num);
+    sync_wait(reduce_range_func(vec, grain, sum));
+
+    int64_t expect = 0;
+    for (int i = 0; i < num; i++)
+    {
+        expect += static_cast<int64_t>(i) * i;
+    }
+    ASSERT_EQ(sum, expect);
+}
+
+TEST_P(ParallelTest, Exception)
+{
+    int thread_num, num, grain;
+    std::tie(thread_num, num, grain) = GetParam();
+    if (num == 0)
+    {
+        GTEST_SKIP();
+    }
+
+    std::atomic<int> cnt{0};
+    bool             caught = false;
+
+    scheduler::init(thread_num);
+    sync_wait(throw_func(num, cnt, caught));
+
+    ASSERT_TRUE(caught);
+    ASSERT_LE(cnt.load(), num);
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    ParallelTests,
+    ParallelTest,
+    ::testing::Values(
+        std::make_tuple(1, 0, 1),
+        std::make_tuple(1, 1000, 16),
+        std::make_tuple(0, 1000, 1),
+        std::make_tuple(4, 1, 1),
+        std::make_tuple(4, 1001, 7),
+        std::make_tuple(4, 100000, 0),
+        std::make_tuple(8, 100000, 1024)));
+
+TEST(ParallelSpreadTest, AllContextsRun)
+{
+    constexpr int kNum = 40000;
+
+    scheduler::init(4);
+    std::vector<std::atomic<int>> ctx_cnt(scheduler::context_count());
+    std::atomic<size_t>           seen{0};
+    sync_wait(for_ctx_func(kNum, 16, ctx_cnt, seen));
+
+    int total = 0;
+    for (auto& cnt : ctx_cnt)
+    {
+        ASSERT_GT(cnt.load(), 0);
+        total += cnt.load();
+    }
+    ASSERT_EQ(total, kNum);
+}
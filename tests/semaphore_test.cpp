@@ -0,0 +1,180 @@
+#include <atomic>
+#include <tuple>
+#include <vector>
+
+#include "coro/coro.hpp"
+#include "coro/comp/event.hpp"
+#include "coro/comp/semaphore.hpp"
+#include "gtest/gtest.h"
+
+using namespace coro;
+
+/*************************************************************
+ *                       pre-definition                      *
+ *************************************************************/
+
+int main(int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
+
+class SemaphoreTest : public ::testing::TestWithParam<std::tuple<int, int, int>>
+{
+protected:
+    void SetUp() override
+    {
+        m_inside = 0;
+        m_max    = 0;
+        m_done   = 0;
+    }
+
+    std::atomic<int> m_inside; // 同时持有许可的协程数
+    std::atomic<int> m_max;    // m_inside出现过的最大值
+    std::atomic<int> m_done;
+};
+
+class SemaphoreOrderTest : public ::testing::Test
+{
+protected:
+    event<>          m_ev;
+    std::vector<int> m_vec;
+};
+
+task<> limit_func(counting_semaphore& sem, std::atomic<int>& inside, std::atomic<int>& max, std::atomic<int>& done)
+{
+    for (int i = 0; i < 10; i++)
+    {
+        co_await sem.acquire();
+        auto cnt = inside.fetch_add(1, std::memory_order_acq_rel) + 1;
+        auto cur = max.load(std::memory_order_acquire);
+        while (cnt > cur && !max.compare_exchange_weak(cur, cnt, std::memory_order_acq_rel)) {}
+        inside.fetch_sub(1, std::memory_order_acq_rel);
+        sem.release();
+    }
+    done.fetch_add(1, std::memory_order_acq_rel);
+}
+
+// 持有唯一的许可直到event被设置, 使后续的协程进入等待队列
+task<> hold_func(counting_semaphore& sem, event<>& ev, std::vector<int>& vec)
+{
+    co_await sem.acquire();
+    co_await ev.wait();
+    vec.push_back(-1);
+    sem.release();
+}
+
+task<> order_func(counting_semaphore& sem, std::vector<int>& vec, int id)
+{
+    co_await sem.acquire();
+    vec.push_back(id);
+    sem.release();
+}
+
+task<> release_func(event<>& ev)
+{
+    ev.set();
+    co_return;
+}
+
+task<> bulk_wait_func(counting_semaphore& sem, std::vector<int>& vec, int id)
+{
+    co_await sem.acquire();
+    vec.push_back(id);
+}
+
+task<> bulk_release_func(counting_semaphore& sem, int update)
+{
+    sem.release(update);
+    co_return;
+}
+
+/*************************************************************
+ *                          tests                            *
+ *************************************************************/
+
+TEST(SemaphoreBaseTest, TryAcquire)
+{
+    counting_semaphore sem(2);
+    ASSERT_EQ(sem.available(), 2);
+    ASSERT_TRUE(sem.try_acquire());
+    ASSERT_TRUE(sem.try_acquire());
+    ASSERT_FALSE(sem.try_acquire());
+    ASSERT_EQ(sem.available(), 0);
+    sem.release(2);
+    ASSERT_EQ(sem.available(), 2);
+}
+
+TEST_P(SemaphoreTest, LimitConcurrency)
+{
+    int thread_num, task_num, permits;
+    std::tie(thread_num, task_num, permits) = GetParam();
+
+    counting_semaphore sem(permits);
+
+    scheduler::init(thread_num);
+    for (int i = 0; i < task_num; i++)
+    {
+        submit_to_scheduler(limit_func(sem, m_inside, m_max, m_done));
+    }
+    scheduler::loop();
+
+    ASSERT_EQ(m_done.load(), task_num);
+    ASSERT_LE(m_max.load(), permits);
+    ASSERT_EQ(sem.available(), permits);
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    SemaphoreTests,
+    SemaphoreTest,
+    ::testing::Values(
+        std::make_tuple(1, 100, 1),
+        std::make_tuple(1, 100, 4),
+        std::make_tuple(0, 100, 1),
+        std::make_tuple(0, 1000, 8),
+        std::make_tuple(4, 1000, 1),
+        std::make_tuple(4, 1000, 3)));
+
+TEST_F(SemaphoreOrderTest, FifoWaiters)
+{
+    constexpr int      kWaiterNum = 100;
+    counting_semaphore sem(1);
+
+    scheduler::init(1);
+    submit_to_scheduler(hold_func(sem, m_ev, m_vec));
+    for (int i = 0; i < kWaiterNum; i++)
+    {
+        submit_to_scheduler(order_func(sem, m_vec, i));
+    }
+    submit_to_scheduler(release_func(m_ev));
+    scheduler::loop();
+
+    ASSERT_EQ(m_vec.size(), kWaiterNum + 1);
+    ASSERT_EQ(m_vec[0], -1);
+    for (int i = 0; i < kWaiterNum; i++)
+    {
+        ASSERT_EQ(m_vec[i + 1], i);
+    }
+    ASSERT_EQ(sem.available(), 1);
+}
+
+TEST_F(SemaphoreOrderTest, BulkRelease)
+{
+    counting_semaphore sem(0);
+
+    scheduler::init(1);
+    for (int i = 0; i < 10; i++)
+    {
+        submit_to_scheduler(bulk_wait_func(sem, m_vec, i));
+    }
+    // 多出的许可留在信号量中
+    submit_to_scheduler(bulk_release_func(sem, 12));
+    scheduler::loop();
+
+    ASSERT_EQ(m_vec.size(), 10);
+    for (int i = 0; i < 10; i++)
+    {
+        ASSERT_EQ(m_vec[i], i);
+    }
+    ASSERT_EQ(sem.available(), 2);
+}
@@ -0,0 +1,144 @@
+#include <stdexcept>
+#include <vector>
+
+#include "coro/coro.hpp"
+#include "coro/sharded.hpp"
+#include "gtest/gtest.h"
+
+using namespace coro;
+
+/*************************************************************
+ *                       pre-definition                      *
+ *************************************************************/
+
+int main(int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
+
+class ShardedTest : public ::testing::TestWithParam<int>
+{
+};
+
+/**
+ * @brief 分片状态, 只由所属的context访问, 因此没有任何原子变量
+ */
+struct counter
+{
+    explicit counter(int init) noexcept : val(init) {}
+
+    int              val;
+    std::vector<int> owners; // 每次访问时所在的context
+};
+
+task<int> async_read(counter& c)
+{
+    co_return c.val;
+}
+
+task<> invoke_all_func(sharded<counter>& s, int round)
+{
+    for (int i = 0; i < round; i++)
+    {
+        co_await s.invoke_on_all(
+            [](counter& c)
+            {
+                c.val++;
+                c.owners.push_back(local_context().get_index());
+            });
+    }
+}
+
+task<> invoke_on_func(sharded<counter>& s, std::vector<int>& vals, int& mismatch)
+{
+    auto origin = local_context().get_index();
+    for (size_t i = 0; i < s.size(); i++)
+    {
+        auto val = co_await s.invoke_on(
+            i,
+            [](counter& c)
+            {
+                c.owners.push_back(local_context().get_index());
+                return c.val;
+            });
+        vals.push_back(val);
+        mismatch += local_context().get_index() != origin ? 1 : 0;
+    }
+    for (size_t i = 0; i < s.size(); i++)
+    {
+        auto val = co_await s.invoke_on(i, [](counter& c) { return async_read(c); });
+        vals.push_back(val);
+        mismatch += local_context().get_index() != origin ? 1 : 0;
+    }
+}
+
+task<> invoke_throw_func(int ctx_id, bool& caught, int& mismatch)
+{
+    auto origin = local_context().get_index();
+    try
+    {
+        co_await invoke_on(ctx_id, []() { throw std::runtime_error("sharded test"); });
+    }
+    catch (const std::runtime_error&)
+    {
+        caught = true;
+    }
+    mismatch += local_context().get_index() != origin ? 1 : 0;
+}
+
+/*************************************************************
+ *                          tests                            *
+ *************************************************************/
+
+TEST_P(ShardedTest, InvokeOnAll)
+{
+    constexpr int kRound = 10;
+
+    scheduler::init(GetParam());
+    sharded<counter> s(1);
+    ASSERT_EQ(s.size(), scheduler::context_count());
+
+    sync_wait(invoke_all_func(s, kRound));
+
+    for (size_t i = 0; i < s.size(); i++)
+    {
+        ASSERT_EQ(s.get(i).val, kRound + 1);
+        ASSERT_EQ(s.get(i).owners.size(), kRound);
+        for (auto owner : s.get(i).owners)
+        {
+            ASSERT_EQ(owner, i);
+        }
+    }
+}
+
+TEST_P(ShardedTest, InvokeOn)
+{
+    scheduler::init(GetParam());
+    sharded<counter> s(7);
+    std::vector<int> vals;
+    int              mismatch = 0;
+
+    sync_wait(invoke_on_func(s, vals, mismatch));
+
+    ASSERT_EQ(mismatch, 0);
+    ASSERT_EQ(vals, std::vector<int>(2 * s.size(), 7));
+    for (size_t i = 0; i < s.size(); i++)
+    {
+        ASSERT_EQ(s.get(i).owners, std::vector<int>({static_cast<int>(i)}));
+    }
+}
+
+TEST_P(ShardedTest, InvokeOnException)
+{
+    scheduler::init(GetParam());
+    bool caught   = false;
+    int  mismatch = 0;
+
+    sync_wait(invoke_throw_func(scheduler::context_count() - 1, caught, mismatch));
+
+    ASSERT_TRUE(caught);
+    ASSERT_EQ(mismatch, 0);
+}
+
+INSTANTIATE_TEST_SUITE_P(ShardedTests, ShardedTest, ::testing::Values(1, 2, 4, 8));
@@ -0,0 +1,189 @@
+#include <atomic>
+#include <tuple>
+#include <vector>
+
+#include "coro/coro.hpp"
+#include "coro/comp/event.hpp"
+#include "coro/comp/shared_mutex.hpp"
+#include "gtest/gtest.h"
+
+using namespace coro;
+
+/*************************************************************
+ *                       pre-definition                      *
+ *************************************************************/
+
+int main(int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
+
+struct shared_data
+{
+    int              first{0}; // 写者在临界区内同时修改first与second
+    int              second{0};
+    std::atomic<int> writers{0}; // 处于临界区内的写者数
+    std::atomic<int> readers{0}; // 处于临界区内的读者数
+    std::atomic<int> errors{0};  // 检测到的互斥错误数
+};
+
+class SharedMutexTest : public ::testing::TestWithParam<std::tuple<int, int>>
+{
+protected:
+    shared_mutex m_mtx;
+    shared_data  m_data;
+};
+
+class SharedMutexOrderTest : public ::testing::Test
+{
+protected:
+    shared_mutex     m_mtx;
+    event<>          m_ev;
+    std::vector<int> m_vec;
+};
+
+task<> writer_func(shared_mutex& mtx, shared_data& data, int loop)
+{
+    for (int i = 0; i < loop; i++)
+    {
+        co_await mtx.lock();
+        if (data.writers.fetch_add(1, std::memory_order_acq_rel) != 0 || data.readers.load() != 0)
+        {
+            data.errors++;
+        }
+        data.first++;
+        data.second++;
+        data.writers.fetch_sub(1, std::memory_order_acq_rel);
+        mtx.unlock();
+    }
+}
+
+task<> reader_func(shared_mutex& mtx, shared_data& data, int loop)
+{
+    for (int i = 0; i < loop; i++)
+    {
+        co_await mtx.lock_shared();
+        data.readers.fetch_add(1, std::memory_order_acq_rel);
+        if (data.writers.load() != 0 || data.first != data.second)
+        {
+            data.errors++;
+        }
+        data.readers.fetch_sub(1, std::memory_order_acq_rel);
+        mtx.unlock_shared();
+    }
+}
+
+// 持有读锁后等待event, 使后续的写者与读者进入等待
+task<> hold_shared_func(shared_mutex& mtx, event<>& ev, std::vector<int>& vec, int id)
+{
+    co_await mtx.lock_shared();
+    co_await ev.wait();
+    vec.push_back(id);
+    mtx.unlock_shared();
+}
+
+task<> order_writer_func(shared_mutex& mtx, std::vector<int>& vec, int id)
+{
+    co_await mtx.lock();
+    vec.push_back(id);
+    mtx.unlock();
+}
+
+task<> order_reader_func(shared_mutex& mtx, std::vector<int>& vec, int id)
+{
+    co_await mtx.lock_shared();
+    vec.push_back(id);
+    mtx.unlock_shared();
+}
+
+task<> release_func(event<>& ev)
+{
+    ev.set();
+    co_return;
+}
+
+/*************************************************************
+ *                          tests                            *
+ *************************************************************/
+
+TEST(SharedMutexBaseTest, TryLock)
+{
+    shared_mutex mtx;
+    ASSERT_TRUE(mtx.try_lock_shared());
+    ASSERT_TRUE(mtx.try_lock_shared());
+    ASSERT_FALSE(mtx.try_lock());
+    mtx.unlock_shared();
+    mtx.unlock_shared();
+
+    ASSERT_TRUE(mtx.try_lock());
+    ASSERT_FALSE(mtx.try_lock_shared());
+    ASSERT_FALSE(mtx.try_lock());
+    mtx.unlock();
+    ASSERT_TRUE(mtx.try_lock_shared());
+    mtx.unlock_shared();
+}
+
+TEST_P(SharedMutexTest, ReadersAndWriters)
+{
+    int thread_num, task_num;
+    std::tie(thread_num, task_num) = GetParam();
+
+    scheduler::init(thread_num);
+    for (int i = 0; i < task_num; i++)
+    {
+        // 读多写少
+        if (i % 8 == 0)
+        {
+            submit_to_scheduler(writer_func(m_mtx, m_data, 10));
+        }
+        else
+        {
+            submit_to_scheduler(reader_func(m_mtx, m_data, 10));
+        }
+    }
+    scheduler::loop();
+
+    ASSERT_EQ(m_data.errors.load(), 0);
+    ASSERT_EQ(m_data.first, ((task_num + 7) / 8) * 10);
+    ASSERT_EQ(m_data.first, m_data.second);
+    ASSERT_TRUE(m_mtx.try_lock());
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    SharedMutexTests,
+    SharedMutexTest,
+    ::testing::Values(
+        std::make_tuple(1, 1),
+        std::make_tuple(1, 100),
+        std::make_tuple(0, 100),
+        std::make_tuple(0, 1000),
+        std::make_tuple(4, 1000)));
+
+TEST_F(SharedMutexOrderTest, SharedHolders)
+{
+    scheduler::init(1);
+    submit_to_scheduler(hold_shared_func(m_mtx, m_ev, m_vec, 0));
+    submit_to_scheduler(hold_shared_func(m_mtx, m_ev, m_vec, 1));
+    submit_to_scheduler(release_func(m_ev));
+    scheduler::loop();
+
+    // 两个读者同时持有读锁
+    ASSERT_EQ(m_vec.size(), 2);
+    ASSERT_TRUE(m_mtx.try_lock());
+}
+
+TEST_F(SharedMutexOrderTest, WriterPreferring)
+{
+    scheduler::init(1);
+    submit_to_scheduler(hold_shared_func(m_mtx, m_ev, m_vec, 0));
+    submit_to_scheduler(order_writer_func(m_mtx, m_vec, 1));
+    // 有写者等待时新的读者必须排在写者之后
+    submit_to_scheduler(order_reader_func(m_mtx, m_vec, 2));
+    submit_to_scheduler(order_writer_func(m_mtx, m_vec, 3));
+    submit_to_scheduler(release_func(m_ev));
+    scheduler::loop();
+
+    ASSERT_EQ(m_vec, std::vector<int>({0, 1, 3, 2}));
+    ASSERT_TRUE(m_mtx.try_lock());
+}
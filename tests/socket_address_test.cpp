@@ -0,0 +1,160 @@
+#include <arpa/inet.h>
+#include <cstddef>
+#include <cstring>
+#include <netinet/in.h>
+#include <poll.h>
+#include <string>
+#include <sys/un.h>
+#include <vector>
+
+#include "coro/coro.hpp"
+#include "coro/io/net/socket_address.hpp"
+#include "coro/io/net/tcp/tcp.hpp"
+#include "gtest/gtest.h"
+
+using namespace coro;
+using io::net::socket_address;
+using io::net::tcp::tcp_client;
+using io::net::tcp::tcp_connector;
+using io::net::tcp::tcp_server;
+
+/*************************************************************
+ *                       pre-definition                      *
+ *************************************************************/
+
+int main(int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
+
+class SocketAddressTest : public ::testing::Test
+{
+protected:
+    static constexpr int kPort = 8103;
+
+    std::vector<int> m_vec;
+};
+
+class SocketAddressConnectTest : public ::testing::TestWithParam<const char*>
+{
+protected:
+    static constexpr int kPort = 8104;
+
+    std::vector<int> m_vec;
+};
+
+// 服务端监听双栈通配地址, 客户端分别使用ipv4与ipv6连接
+task<> dual_stack_func(const char* client_addr, int port, std::vector<int>& vec)
+{
+    auto server = tcp_server(nullptr, port);
+    auto client = tcp_client(client_addr, port);
+
+    int clientfd = co_await client.connect();
+    vec.push_back(clientfd > 0);
+
+    pollfd pfd{.fd = server.fd(), .events = POLLIN, .revents = 0};
+    vec.push_back(::poll(&pfd, 1, 1000));
+
+    int serverfd = co_await server.accept();
+    vec.push_back(serverfd > 0);
+
+    auto cli = tcp_connector(clientfd);
+    auto svr = tcp_connector(serverfd);
+
+    char msg[]   = "dual stack";
+    char buf[32] = {0};
+    vec.push_back(co_await cli.write(msg, sizeof(msg)));
+    vec.push_back(co_await svr.read(buf, sizeof(buf)));
+    vec.push_back(strcmp(buf, msg));
+
+    co_await cli.close();
+    co_await svr.close();
+}
+
+/*************************************************************
+ *                          tests                            *
+ *************************************************************/
+
+TEST_F(SocketAddressTest, DefaultInvalid)
+{
+    socket_address addr;
+    ASSERT_FALSE(addr.valid());
+    ASSERT_EQ(addr.size(), 0);
+}
+
+TEST_F(SocketAddressTest, ParseIPv4)
+{
+    auto addr = socket_address::parse("127.0.0.1", kPort);
+    ASSERT_TRUE(addr.is_ipv4());
+    ASSERT_EQ(addr.size(), sizeof(sockaddr_in));
+    ASSERT_EQ(addr.port(), kPort);
+    ASSERT_FALSE(addr.is_any());
+
+    auto sin = reinterpret_cast<const sockaddr_in*>(addr.data());
+    ASSERT_EQ(sin->sin_addr.s_addr, htonl(INADDR_LOOPBACK));
+}
+
+TEST_F(SocketAddressTest, ParseIPv6)
+{
+    auto addr = socket_address::parse("::1", kPort);
+    ASSERT_TRUE(addr.is_ipv6());
+    ASSERT_EQ(addr.size(), sizeof(sockaddr_in6));
+    ASSERT_EQ(addr.port(), kPort);
+
+    auto sin6 = reinterpret_cast<const sockaddr_in6*>(addr.data());
+    ASSERT_TRUE(IN6_IS_ADDR_LOOPBACK(&sin6->sin6_addr));
+}
+
+TEST_F(SocketAddressTest, ParseInvalid)
+{
+    ASSERT_FALSE(socket_address::parse("256.0.0.1", kPort).valid());
+    ASSERT_FALSE(socket_address::parse("::g", kPort).valid());
+    ASSERT_FALSE(socket_address::ipv4("::1", kPort).valid());
+    ASSERT_FALSE(socket_address::ipv6("127.0.0.1", kPort).valid());
+}
+
+TEST_F(SocketAddressTest, AnyIsDualStack)
+{
+    auto addr = socket_address::parse(nullptr, kPort);
+    ASSERT_TRUE(addr.is_ipv6());
+    ASSERT_TRUE(addr.is_any());
+
+    auto v4 = socket_address::any_ipv4(kPort);
+    ASSERT_TRUE(v4.is_ipv4());
+    ASSERT_TRUE(v4.is_any());
+}
+
+TEST_F(SocketAddressTest, UnixPath)
+{
+    auto addr = socket_address::unix_path("/tmp/coro.sock");
+    ASSERT_TRUE(addr.is_unix());
+    ASSERT_EQ(addr.size(), offsetof(sockaddr_un, sun_path) + sizeof("/tmp/coro.sock"));
+
+    auto abstract = socket_address::unix_path("@coro");
+    ASSERT_TRUE(abstract.is_unix());
+    ASSERT_EQ(abstract.size(), offsetof(sockaddr_un, sun_path) + strlen("@coro"));
+    ASSERT_EQ(reinterpret_cast<const sockaddr_un*>(abstract.data())->sun_path[0], '\0');
+
+    ASSERT_FALSE(socket_address::unix_path("").valid());
+    ASSERT_FALSE(socket_address::unix_path(std::string(sizeof(sockaddr_un{}.sun_path), 'x').c_str()).valid());
+}
+
+TEST_P(SocketAddressConnectTest, DualStackServer)
+{
+    scheduler::init(1);
+    // tcp_server不会关闭监听socket, 每组参数使用不同的端口
+    const int port = kPort + (strchr(GetParam(), ':') != nullptr ? 1 : 0);
+    submit_to_scheduler(dual_stack_func(GetParam(), port, m_vec));
+    scheduler::loop();
+
+    ASSERT_EQ(m_vec.size(), 6);
+    ASSERT_EQ(m_vec[0], 1);
+    ASSERT_EQ(m_vec[1], 1);
+    ASSERT_EQ(m_vec[2], 1);
+    ASSERT_EQ(m_vec[3], sizeof("dual stack"));
+    ASSERT_EQ(m_vec[4], sizeof("dual stack"));
+    ASSERT_EQ(m_vec[5], 0);
+}
+
+INSTANTIATE_TEST_SUITE_P(SocketAddressConnectTests, SocketAddressConnectTest, ::testing::Values("127.0.0.1", "::1"));
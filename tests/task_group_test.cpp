@@ -0,0 +1,300 @@
+#include <atomic>
+#include <stdexcept>
+#include <stop_token>
+#include <tuple>
+
+#include "coro/comp/channel.hpp"
+#include "coro/comp/task_group.hpp"
+#include "coro/coro.hpp"
+#include "gtest/gtest.h"
+
+using namespace coro;
+
+/*************************************************************
+ *                       pre-definition                      *
+ *************************************************************/
+
+int main(int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
+
+class TaskGroupTest : public ::testing::TestWithParam<std::tuple<int, int>>
+{
+};
+
+task<> count_func(std::atomic<int>& cnt)
+{
+    cnt.fetch_add(1, std::memory_order_acq_rel);
+    co_return;
+}
+
+task<> throw_func()
+{
+    throw std::runtime_error("task_group test");
+    co_return;
+}
+
+/**
+ * @brief 一直阻塞在channel上, 只有取消时channel被关闭才会返回
+ */
+task<> blocked_func(channel<int>& ch, std::stop_token token, std::atomic<int>& cancelled)
+{
+    std::stop_callback cb(token, [&ch]() { ch.close(); });
+    auto               val = co_await ch.recv();
+    if (!val.has_value())
+    {
+        cancelled.fetch_add(1, std::memory_order_acq_rel);
+    }
+}
+
+task<> spawn_func(int task_num, std::atomic<int>& cnt)
+{
+    task_group group;
+    for (int i = 0; i < task_num; i++)
+    {
+        group.spawn(count_func(cnt));
+    }
+    co_await group.wait();
+}
+
+task<> spawn_on_func(int task_num, std::atomic<int>& cnt)
+{
+    task_group group;
+    for (int i = 0; i < task_num; i++)
+    {
+        group.spawn(count_func(cnt), i % scheduler::context_count());
+    }
+    co_await group.wait();
+}
+
+task<> reuse_func(int task_num, std::atomic<int>& cnt)
+{
+    task_group group;
+    for (int round = 0; round < 3; round++)
+    {
+        for (int i = 0; i < task_num; i++)
+        {
+            group.spawn(count_func(cnt));
+        }
+        co_await group.wait();
+    }
+}
+
+/**
+ * @brief 记录子任务开始时是否已经被请求取消
+ */
+task<> observe_func(std::stop_token token, std::atomic<int>& cnt, std::atomic<int>& stopped)
+{
+    cnt.fetch_add(1, std::memory_order_acq_rel);
+    if (token.stop_requested())
+    {
+        stopped.fetch_add(1, std::memory_order_acq_rel);
+    }
+    co_return;
+}
+
+/**
+ * @brief 第一轮有子任务失败, 第二轮全部成功, 第二轮不应看到第一轮的异常与取消请求
+ */
+task<> reuse_after_failure_func(
+    int task_num, std::atomic<int>& cnt, std::atomic<int>& stopped, int& first_caught, int& second_caught)
+{
+    task_group group;
+    group.spawn(throw_func());
+    try
+    {
+        co_await group.wait();
+    }
+    catch (const std::runtime_error&)
+    {
+        first_caught++;
+    }
+
+    for (int i = 0; i < task_num; i++)
+    {
+        group.spawn(observe_func(group.get_stop_token(), cnt, stopped));
+    }
+    try
+    {
+        co_await group.wait();
+    }
+    catch (const std::runtime_error&)
+    {
+        second_caught++;
+    }
+}
+
+task<> cancel_func(int task_num, std::atomic<int>& cancelled, bool& caught)
+{
+    channel<int> ch(0);
+    task_group   group;
+    for (int i = 0; i < task_num; i++)
+    {
+        group.spawn(blocked_func(ch, group.get_stop_token(), cancelled));
+    }
+    group.spawn(throw_func());
+    try
+    {
+        co_await group.wait();
+    }
+    catch (const std::runtime_error&)
+    {
+        caught = true;
+    }
+}
+
+task<> request_stop_func(int task_num, std::atomic<int>& cancelled)
+{
+    channel<int> ch(0);
+    task_group   group;
+    for (int i = 0; i < task_num; i++)
+    {
+        group.spawn(blocked_func(ch, group.get_stop_token(), cancelled));
+    }
+    group.request_stop();
+    co_await group.wait();
+}
+
+/**
+ * @brief 记录以非high优先级运行的次数
+ */
+task<> prio_func(std::atomic<int>& mismatch)
+{
+    co_await yield();
+    if (detail::linfo.prio != task_priority::high)
+    {
+        mismatch.fetch_add(1, std::memory_order_acq_rel);
+    }
+}
+
+task<> prio_spawn_func(int task_num, std::atomic<int>& mismatch)
+{
+    task_group group;
+    for (int i = 0; i < task_num; i++)
+    {
+        group.spawn(prio_func(mismatch));
+    }
+    co_await group.wait();
+    if (detail::linfo.prio != task_priority::high)
+    {
+        mismatch.fetch_add(1, std::memory_order_acq_rel);
+    }
+}
+
+/*************************************************************
+ *                          tests                            *
+ *************************************************************/
+
+TEST_P(TaskGroupTest, Spawn)
+{
+    int thread_num, task_num;
+    std::tie(thread_num, task_num) = GetParam();
+
+    std::atomic<int> cnt{0};
+
+    scheduler::init(thread_num);
+    sync_wait(spawn_func(task_num, cnt));
+
+    ASSERT_EQ(cnt.load(), task_num);
+}
+
+TEST_P(TaskGroupTest, SpawnOn)
+{
+    int thread_num, task_num;
+    std::tie(thread_num, task_num) = GetParam();
+
+    std::atomic<int> cnt{0};
+
+    scheduler::init(thread_num);
+    sync_wait(spawn_on_func(task_num, cnt));
+
+    ASSERT_EQ(cnt.load(), task_num);
+}
+
+TEST_P(TaskGroupTest, Reuse)
+{
+    int thread_num, task_num;
+    std::tie(thread_num, task_num) = GetParam();
+
+    std::atomic<int> cnt{0};
+
+    scheduler::init(thread_num);
+    sync_wait(reuse_func(task_num, cnt));
+
+    ASSERT_EQ(cnt.load(), 3 * task_num);
+}
+
+TEST_P(TaskGroupTest, ReuseAfterFailure)
+{
+    int thread_num, task_num;
+    std::tie(thread_num, task_num) = GetParam();
+
+    std::atomic<int> cnt{0};
+    std::atomic<int> stopped{0};
+    int              first_caught  = 0;
+    int              second_caught = 0;
+
+    scheduler::init(thread_num);
+    sync_wait(reuse_after_failure_func(task_num, cnt, stopped, first_caught, second_caught));
+
+    ASSERT_EQ(first_caught, 1);
+    ASSERT_EQ(second_caught, 0);
+    ASSERT_EQ(cnt.load(), task_num);
+    ASSERT_EQ(stopped.load(), 0);
+}
+
+TEST_P(TaskGroupTest, FailureCancelsSiblings)
+{
+    int thread_num, task_num;
+    std::tie(thread_num, task_num) = GetParam();
+
+    std::atomic<int> cancelled{0};
+    bool             caught = false;
+
+    scheduler::init(thread_num);
+    sync_wait(cancel_func(task_num, cancelled, caught));
+
+    ASSERT_TRUE(caught);
+    ASSERT_EQ(cancelled.load(), task_num);
+}
+
+TEST_P(TaskGroupTest, RequestStop)
+{
+    int thread_num, task_num;
+    std::tie(thread_num, task_num) = GetParam();
+
+    std::atomic<int> cancelled{0};
+
+    scheduler::init(thread_num);
+    sync_wait(request_stop_func(task_num, cancelled));
+
+    ASSERT_EQ(cancelled.load(), task_num);
+}
+
+// 测试子任务继承调用者的优先级, 等待者恢复后仍以原有的优先级运行
+TEST_P(TaskGroupTest, KeepPriority)
+{
+    int thread_num, task_num;
+    std::tie(thread_num, task_num) = GetParam();
+
+    std::atomic<int> mismatch{0};
+
+    scheduler::init(thread_num);
+    scheduler::submit(prio_spawn_func(task_num, mismatch), task_priority::high);
+    scheduler::loop();
+
+    ASSERT_EQ(mismatch.load(), 0);
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    TaskGroupTests,
+    TaskGroupTest,
+    ::testing::Values(
+        std::make_tuple(1, 0),
+        std::make_tuple(1, 1),
+        std::make_tuple(1, 100),
+        std::make_tuple(0, 100),
+        std::make_tuple(4, 1000),
+        std::make_tuple(8, 10000)));
@@ -1,11 +1,14 @@
 #include <algorithm>
+#include <cstdint>
 #include <cstdlib>
 #include <ctime>
+#include <memory>
 #include <tuple>
 #include <vector>
 
 #include "coro/coro.hpp"
 #include "coro/comp/wait_group.hpp"
+#include "coro/detail/resume_batch.hpp"
 #include "gtest/gtest.h"
 
 using namespace coro;
@@ -46,6 +49,26 @@ task<> wait_func(wait_group& wg, std::atomic<int>& id, int* data)
     *data = id.fetch_add(1, std::memory_order_acq_rel);
 }
 
+struct fake_awaiter
+{
+    context&                m_ctx;
+    fake_awaiter*           m_next{nullptr};
+    std::coroutine_handle<> m_await_coro{nullptr};
+    detail::task_priority   m_prio{detail::task_priority::normal};
+};
+
+task<> prio_wait_func(wait_group& wg, std::vector<int>& vec)
+{
+    co_await wg.wait();
+    vec.push_back(static_cast<int>(detail::linfo.prio));
+}
+
+task<> prio_done_func(wait_group& wg)
+{
+    wg.done();
+    co_return;
+}
+
 /*************************************************************
  *                          tests                            *
  *************************************************************/
@@ -87,6 +110,106 @@ TEST_P(WaitgroupTest, DoneAndWait)
     }
 }
 
+// 测试按context分组唤醒时, context数量超过分组表大小也保持每个context内的相对顺序
+TEST(ResumeGroupedTest, KeepOrderPerContext)
+{
+    const size_t ctx_num    = detail::kResumeBucketNum + 7;
+    const size_t waiter_num = 5;
+
+    std::vector<std::unique_ptr<context>> ctxs;
+    for (size_t i = 0; i < ctx_num; i++)
+    {
+        ctxs.push_back(std::make_unique<context>());
+    }
+
+    // 各context的等待者交错排列, 句柄只用于标识, 不会被恢复
+    std::vector<std::unique_ptr<fake_awaiter>> waiters;
+    fake_awaiter*                              head = nullptr;
+    fake_awaiter**                             tail = &head;
+    for (size_t k = 0; k < waiter_num; k++)
+    {
+        for (size_t i = 0; i < ctx_num; i++)
+        {
+            auto id = reinterpret_cast<void*>((i * waiter_num + k + 1) * 16);
+            waiters.push_back(std::make_unique<fake_awaiter>(fake_awaiter{
+                .m_ctx = *ctxs[i], .m_await_coro = std::coroutine_handle<>::from_address(id)}));
+            *tail = waiters.back().get();
+            tail  = &waiters.back()->m_next;
+        }
+    }
+
+    detail::resume_grouped(head);
+
+    for (size_t i = 0; i < ctx_num; i++)
+    {
+        auto& engine = ctxs[i]->get_engine();
+        ASSERT_EQ(engine.num_task_schedule(detail::task_priority::normal), waiter_num);
+        for (size_t k = 0; k < waiter_num; k++)
+        {
+            ASSERT_EQ(engine.schedule().address(), reinterpret_cast<void*>((i * waiter_num + k + 1) * 16));
+        }
+    }
+}
+
+// 测试按context与优先级分组唤醒时, 等待者回到各自优先级的任务队列并保持相对顺序
+TEST(ResumeGroupedTest, KeepPriority)
+{
+    const size_t waiter_num = 6;
+
+    context ctx(engine_options{.prio_queue_cap = config::kQueCap});
+
+    std::vector<std::unique_ptr<fake_awaiter>> waiters;
+    fake_awaiter*                              head = nullptr;
+    fake_awaiter**                             tail = &head;
+    for (size_t k = 0; k < waiter_num; k++)
+    {
+        auto id = reinterpret_cast<void*>((k + 1) * 16);
+        waiters.push_back(std::make_unique<fake_awaiter>(fake_awaiter{
+            .m_ctx        = ctx,
+            .m_await_coro = std::coroutine_handle<>::from_address(id),
+            .m_prio       = static_cast<detail::task_priority>(k % 3)}));
+        *tail = waiters.back().get();
+        tail  = &waiters.back()->m_next;
+    }
+
+    detail::resume_grouped(head);
+
+    auto& engine = ctx.get_engine();
+    for (size_t p = 0; p < 3; p++)
+    {
+        auto prio = static_cast<detail::task_priority>(p);
+        ASSERT_EQ(engine.num_task_schedule(prio), waiter_num / 3);
+        for (size_t k = p; k < waiter_num; k += 3)
+        {
+            ASSERT_EQ(engine.schedule(prio).address(), reinterpret_cast<void*>((k + 1) * 16));
+        }
+    }
+}
+
+// 测试高优先级的协程等待wait_group后仍以高优先级运行
+TEST(WaitgroupPriorityTest, WakeupKeepPriority)
+{
+    const int task_num = 100;
+
+    context          ctx(engine_options{.prio_queue_cap = config::kQueCap});
+    wait_group       wg(1);
+    std::vector<int> vec;
+    for (int i = 0; i < task_num; i++)
+    {
+        ctx.submit_task(prio_wait_func(wg, vec), detail::task_priority::high);
+        ctx.submit_task(prio_wait_func(wg, vec));
+    }
+    // 唤醒者最后运行, 此时全部等待者都已挂起
+    ctx.submit_task(prio_done_func(wg), detail::task_priority::low);
+
+    ctx.start();
+    ctx.join();
+
+    ASSERT_EQ(vec.size(), 2 * task_num);
+    ASSERT_EQ(std::count(vec.begin(), vec.end(), static_cast<int>(detail::task_priority::high)), task_num);
+    ASSERT_EQ(std::count(vec.begin(), vec.end(), static_cast<int>(detail::task_priority::normal)), task_num);
+}
+
 INSTANTIATE_TEST_SUITE_P(
     WaitgroupTests,
     WaitgroupTest,
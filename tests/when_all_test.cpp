@@ -0,0 +1,222 @@
+#include <atomic>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <variant>
+#include <vector>
+
+#include "coro/coro.hpp"
+#include "coro/comp/event.hpp"
+#include "coro/comp/when_all.hpp"
+#include "gtest/gtest.h"
+
+using namespace coro;
+
+/*************************************************************
+ *                       pre-definition                      *
+ *************************************************************/
+
+int main(int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
+
+class WhenAllTest : public ::testing::TestWithParam<std::tuple<int, int>>
+{
+};
+
+task<int> value_func(int val)
+{
+    co_return val;
+}
+
+task<std::string> string_func(std::string str)
+{
+    co_return str;
+}
+
+task<> count_func(std::atomic<int>& cnt)
+{
+    cnt.fetch_add(1, std::memory_order_acq_rel);
+    co_return;
+}
+
+task<int> wait_value_func(event<>& ev, int val)
+{
+    co_await ev.wait();
+    co_return val;
+}
+
+task<> set_func(event<>& ev)
+{
+    ev.set();
+    co_return;
+}
+
+task<int> throw_func()
+{
+    throw std::runtime_error("when_all test");
+    co_return 0;
+}
+
+task<> variadic_func(int& num, std::string& str, std::atomic<int>& cnt)
+{
+    auto res = co_await when_all(value_func(7), string_func("sheep"), count_func(cnt));
+    num      = std::get<0>(res);
+    str      = std::get<1>(res);
+}
+
+task<> range_func(int task_num, bool spread_mode, int& sum)
+{
+    std::vector<task<int>> tasks;
+    for (int i = 0; i < task_num; i++)
+    {
+        tasks.push_back(value_func(i));
+    }
+    std::vector<int> res;
+    if (spread_mode)
+    {
+        res = co_await when_all(spread, std::move(tasks));
+    }
+    else
+    {
+        res = co_await when_all(std::move(tasks));
+    }
+    for (auto val : res)
+    {
+        sum += val;
+    }
+}
+
+task<> range_void_func(int task_num, std::atomic<int>& cnt)
+{
+    std::vector<task<>> tasks;
+    for (int i = 0; i < task_num; i++)
+    {
+        tasks.push_back(count_func(cnt));
+    }
+    co_await when_all(spread, std::move(tasks));
+}
+
+task<> suspend_func(event<>& ev, int& sum)
+{
+    // 子任务挂起后由另一个子任务唤醒, when_all需要等待全部子任务结束
+    auto res = co_await when_all(wait_value_func(ev, 1), wait_value_func(ev, 2), value_func(3), set_func(ev));
+    sum      = std::get<0>(res) + std::get<1>(res) + std::get<2>(res);
+}
+
+task<int> prio_func()
+{
+    co_await yield();
+    co_return static_cast<int>(detail::linfo.prio);
+}
+
+task<> prio_when_all_func(int task_num, std::vector<int>& prios)
+{
+    std::vector<task<int>> tasks;
+    for (int i = 0; i < task_num; i++)
+    {
+        tasks.push_back(prio_func());
+    }
+    prios = co_await when_all(spread, std::move(tasks));
+    prios.push_back(static_cast<int>(detail::linfo.prio));
+}
+
+task<> exception_func(bool& caught)
+{
+    try
+    {
+        co_await when_all(value_func(1), throw_func());
+    }
+    catch (const std::runtime_error&)
+    {
+        caught = true;
+    }
+}
+
+/*************************************************************
+ *                          tests                            *
+ *************************************************************/
+
+TEST_P(WhenAllTest, Variadic)
+{
+    int              num = 0;
+    std::string      str;
+    std::atomic<int> cnt{0};
+
+    scheduler::init(std::get<0>(GetParam()));
+    sync_wait(variadic_func(num, str, cnt));
+
+    ASSERT_EQ(num, 7);
+    ASSERT_EQ(str, "sheep");
+    ASSERT_EQ(cnt.load(), 1);
+}
+
+TEST_P(WhenAllTest, Range)
+{
+    int thread_num, task_num;
+    std::tie(thread_num, task_num) = GetParam();
+
+    for (auto spread_mode : {false, true})
+    {
+        int sum = 0;
+        scheduler::init(thread_num);
+        sync_wait(range_func(task_num, spread_mode, sum));
+        ASSERT_EQ(sum, task_num * (task_num - 1) / 2);
+    }
+}
+
+TEST_P(WhenAllTest, RangeVoid)
+{
+    int thread_num, task_num;
+    std::tie(thread_num, task_num) = GetParam();
+
+    std::atomic<int> cnt{0};
+    scheduler::init(thread_num);
+    sync_wait(range_void_func(task_num, cnt));
+    ASSERT_EQ(cnt.load(), task_num);
+}
+
+TEST_P(WhenAllTest, SuspendedChildren)
+{
+    event<> ev;
+    int     sum = 0;
+
+    scheduler::init(std::get<0>(GetParam()));
+    sync_wait(suspend_func(ev, sum));
+    ASSERT_EQ(sum, 6);
+}
+
+TEST_P(WhenAllTest, Exception)
+{
+    bool caught = false;
+
+    scheduler::init(std::get<0>(GetParam()));
+    sync_wait(exception_func(caught));
+    ASSERT_TRUE(caught);
+}
+
+// 测试分发的子任务继承等待者的优先级, 等待者恢复后仍以原有的优先级运行
+TEST_P(WhenAllTest, KeepPriority)
+{
+    int thread_num, task_num;
+    std::tie(thread_num, task_num) = GetParam();
+
+    std::vector<int> prios;
+    scheduler::init(thread_num);
+    scheduler::submit(prio_when_all_func(task_num, prios), task_priority::high);
+    scheduler::loop();
+
+    ASSERT_EQ(prios, std::vector<int>(task_num + 1, static_cast<int>(task_priority::high)));
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    WhenAllTests,
+    WhenAllTest,
+    ::testing::Values(
+        std::make_tuple(1, 1),
+        std::make_tuple(1, 20),
+        std::make_tuple(0, 20),
+        std::make_tuple(4, 20),
+        std::make_tuple(4, 1000)));
@@ -0,0 +1,197 @@
+#include <atomic>
+#include <optional>
+#include <stop_token>
+#include <tuple>
+#include <variant>
+#include <vector>
+
+#include "coro/coro.hpp"
+#include "coro/comp/channel.hpp"
+#include "coro/comp/when_any.hpp"
+#include "gtest/gtest.h"
+
+using namespace coro;
+
+/*************************************************************
+ *                       pre-definition                      *
+ *************************************************************/
+
+int main(int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
+
+class WhenAnyTest : public ::testing::TestWithParam<int>
+{
+};
+
+task<int> value_func(int val)
+{
+    co_return val;
+}
+
+/**
+ * @brief 一直等待channel直到被取消, 取消时关闭channel使recv返回
+ */
+task<int> slow_func(channel<int>& ch, std::stop_token token, std::atomic<int>& cancelled)
+{
+    std::stop_callback cb(token, [&ch]() { ch.close(); });
+    auto               val = co_await ch.recv();
+    if (!val.has_value())
+    {
+        cancelled.fetch_add(1, std::memory_order_acq_rel);
+        co_return -1;
+    }
+    co_return *val;
+}
+
+task<> variadic_func(size_t& index, int& val, std::atomic<int>& cancelled)
+{
+    channel<int>     ch(0);
+    std::stop_source stop;
+
+    auto res = co_await when_any(
+        stop,
+        slow_func(ch, stop.get_token(), cancelled),
+        value_func(42),
+        slow_func(ch, stop.get_token(), cancelled));
+    index = res.index();
+    val   = std::get<1>(res);
+}
+
+task<> cancel_losers_func(bool spread_mode, size_t& index, int& val, std::atomic<int>& cancelled)
+{
+    channel<int> ch(0);
+
+    auto slow  = [&](std::stop_token token) { return slow_func(ch, token, cancelled); };
+    auto value = [](std::stop_token) { return value_func(42); };
+
+    std::variant<int, int, int> res;
+    if (spread_mode)
+    {
+        res = co_await when_any(spread, cancel_losers, slow, value, slow);
+    }
+    else
+    {
+        res = co_await when_any(cancel_losers, slow, value, slow);
+    }
+    index = res.index();
+    val   = std::get<1>(res);
+}
+
+/**
+ * @brief 子任务在交给when_any之前已经结束, 它应当成为胜者
+ */
+task<> done_func(size_t& index, int& val, std::atomic<int>& cancelled)
+{
+    channel<int>     ch(0);
+    std::stop_source stop;
+
+    auto done = value_func(42);
+    done.handle().resume();
+
+    std::vector<task<int>> tasks;
+    tasks.push_back(slow_func(ch, stop.get_token(), cancelled));
+    tasks.push_back(std::move(done));
+    tasks.push_back(slow_func(ch, stop.get_token(), cancelled));
+
+    auto res = co_await when_any(stop, std::move(tasks));
+    index    = res.first;
+    val      = res.second;
+}
+
+task<> range_func(int task_num, bool spread_mode, size_t& index, int& val, std::atomic<int>& cancelled)
+{
+    channel<int>     ch(0);
+    std::stop_source stop;
+
+    std::vector<task<int>> tasks;
+    for (int i = 0; i < task_num; i++)
+    {
+        tasks.push_back(slow_func(ch, stop.get_token(), cancelled));
+    }
+    tasks.push_back(value_func(task_num));
+
+    std::pair<size_t, int> res;
+    if (spread_mode)
+    {
+        res = co_await when_any(spread, stop, std::move(tasks));
+    }
+    else
+    {
+        res = co_await when_any(stop, std::move(tasks));
+    }
+    index = res.first;
+    val   = res.second;
+}
+
+/*************************************************************
+ *                          tests                            *
+ *************************************************************/
+
+TEST_P(WhenAnyTest, VariadicCancelLosers)
+{
+    size_t           index = 0;
+    int              val   = 0;
+    std::atomic<int> cancelled{0};
+
+    scheduler::init(GetParam());
+    sync_wait(variadic_func(index, val, cancelled));
+
+    ASSERT_EQ(index, 1);
+    ASSERT_EQ(val, 42);
+    ASSERT_EQ(cancelled.load(), 2);
+}
+
+TEST_P(WhenAnyTest, OwnedStopSourceCancelLosers)
+{
+    for (auto spread_mode : {false, true})
+    {
+        size_t           index = 0;
+        int              val   = 0;
+        std::atomic<int> cancelled{0};
+
+        scheduler::init(GetParam());
+        sync_wait(cancel_losers_func(spread_mode, index, val, cancelled));
+
+        ASSERT_EQ(index, 1);
+        ASSERT_EQ(val, 42);
+        ASSERT_EQ(cancelled.load(), 2);
+    }
+}
+
+TEST_P(WhenAnyTest, RangeCancelLosers)
+{
+    constexpr int kNum = 20;
+
+    for (auto spread_mode : {false, true})
+    {
+        size_t           index = 0;
+        int              val   = 0;
+        std::atomic<int> cancelled{0};
+
+        scheduler::init(GetParam());
+        sync_wait(range_func(kNum, spread_mode, index, val, cancelled));
+
+        ASSERT_EQ(index, kNum);
+        ASSERT_EQ(val, kNum);
+        ASSERT_EQ(cancelled.load(), kNum);
+    }
+}
+
+TEST_P(WhenAnyTest, AlreadyDoneWins)
+{
+    size_t           index = 0;
+    int              val   = 0;
+    std::atomic<int> cancelled{0};
+
+    scheduler::init(GetParam());
+    sync_wait(done_func(index, val, cancelled));
+
+    ASSERT_EQ(index, 1);
+    ASSERT_EQ(val, 42);
+    ASSERT_EQ(cancelled.load(), 2);
+}
+
+INSTANTIATE_TEST_SUITE_P(WhenAnyTests, WhenAnyTest, ::testing::Values(1, 0, 4));
@@ -0,0 +1,178 @@
+#include <atomic>
+#include <tuple>
+#include <vector>
+
+#include "coro/coro.hpp"
+#include "coro/yield.hpp"
+#include "gtest/gtest.h"
+
+using namespace coro;
+
+/*************************************************************
+ *                       pre-definition                      *
+ *************************************************************/
+
+int main(int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
+
+class YieldTest : public ::testing::TestWithParam<int>
+{
+};
+
+task<> interleave_func(std::vector<int>& vec, int id, int num)
+{
+    for (int i = 0; i < num; i++)
+    {
+        vec.push_back(id);
+        co_await yield();
+    }
+}
+
+/**
+ * @brief 不让出时会一直占用context, 使set_func永远无法执行
+ */
+task<> spin_func(std::atomic<bool>& flag, int& spins)
+{
+    while (!flag.load(std::memory_order_acquire))
+    {
+        spins++;
+        co_await yield();
+    }
+}
+
+task<> set_func(std::atomic<bool>& flag)
+{
+    flag.store(true, std::memory_order_release);
+    co_return;
+}
+
+task<int> nested_yield_func(int num)
+{
+    int sum = 0;
+    for (int i = 0; i < num; i++)
+    {
+        sum += i;
+        co_await yield();
+    }
+    co_return sum;
+}
+
+task<> outer_func(int num, int& sum)
+{
+    sum = co_await nested_yield_func(num);
+}
+
+task<> count_func(std::atomic<int>& cnt, int num)
+{
+    for (int i = 0; i < num; i++)
+    {
+        cnt.fetch_add(1, std::memory_order_relaxed);
+        co_await yield();
+    }
+}
+
+/*************************************************************
+ *                          tests                            *
+ *************************************************************/
+
+TEST(YieldSingleTest, Interleave)
+{
+    constexpr int kNum = 100;
+
+    std::vector<int> vec;
+
+    scheduler::init(1);
+    scheduler::submit(interleave_func(vec, 0, kNum), 0);
+    scheduler::submit(interleave_func(vec, 1, kNum), 0);
+    scheduler::loop();
+
+    ASSERT_EQ(vec.size(), 2 * kNum);
+    for (int i = 0; i < 2 * kNum; i++)
+    {
+        ASSERT_EQ(vec[i], i % 2);
+    }
+}
+
+TEST(YieldSingleTest, SpinDoesNotStarve)
+{
+    std::atomic<bool> flag{false};
+    int               spins = 0;
+
+    scheduler::init(1);
+    scheduler::submit(spin_func(flag, spins), 0);
+    scheduler::submit(set_func(flag), 0);
+    scheduler::loop();
+
+    ASSERT_TRUE(flag.load());
+    ASSERT_GE(spins, 1);
+}
+
+TEST(YieldSingleTest, Nested)
+{
+    constexpr int kNum = 1000;
+
+    int sum = 0;
+
+    scheduler::init(1);
+    scheduler::submit(outer_func(kNum, sum), 0);
+    scheduler::loop();
+
+    ASSERT_EQ(sum, kNum * (kNum - 1) / 2);
+}
+
+TEST(YieldSingleTest, BeyondEventfdLimit)
+{
+    // 每次唤醒向eventfd写入engine::task_flag, 超过2^20次不清空时计数会达到上限
+    constexpr int kNum = (1 << 20) + 1000;
+
+    std::atomic<int> cnt{0};
+
+    scheduler::init(1);
+    scheduler::submit(count_func(cnt, kNum), 0);
+    scheduler::loop();
+
+    ASSERT_EQ(cnt.load(), kNum);
+}
+
+TEST_P(YieldTest, ManyTasks)
+{
+    constexpr int kYieldNum = 10;
+
+    int task_num = GetParam();
+
+    std::atomic<int> cnt{0};
+
+    scheduler::init(4);
+    for (int i = 0; i < task_num; i++)
+    {
+        scheduler::submit(count_func(cnt, kYieldNum));
+    }
+    scheduler::loop();
+
+    ASSERT_EQ(cnt.load(), task_num * kYieldNum);
+}
+
+// 测试开启每轮的任务数与时间预算后, 任务仍然全部执行完
+TEST_P(YieldTest, ManyTasksWithBudget)
+{
+    constexpr int kYieldNum = 10;
+
+    int task_num = GetParam();
+
+    std::atomic<int> cnt{0};
+
+    scheduler::init(scheduler_options{
+        .ctx_cnt = 4, .engine_opts = engine_options{.task_budget = 16, .task_time_budget_us = 100}});
+    for (int i = 0; i < task_num; i++)
+    {
+        scheduler::submit(count_func(cnt, kYieldNum));
+    }
+    scheduler::loop();
+
+    ASSERT_EQ(cnt.load(), task_num * kYieldNum);
+}
+
+INSTANTIATE_TEST_SUITE_P(YieldTests, YieldTest, ::testing::Values(1, 100, 1000, 10000));